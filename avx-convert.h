@@ -1,4 +1,7 @@
 #pragma once
+#include <cmath>
+#include <limits>
+#include <type_traits>
 #include <immintrin.h>
 
 #include "sse.h"
@@ -18,7 +21,7 @@ namespace internals
     {
         __m256i mask = avxTailMask32(len);
         __m256 a = _mm256_maskload_ps(pSrc, mask);
-        __m256i b = _mm256_cvtps_epi32(a);
+        __m256i b = _mm256_cvttps_epi32(a);
         _mm256_maskstore_epi32(pDst, mask, b);
     }
 
@@ -47,7 +50,7 @@ namespace internals
     INLINE void convertTail(const double * pSrc, int32_t * pDst, int len)
     {
         __m256d a = _mm256_maskload_pd(pSrc, avxTailMask64(len));
-        __m128i b = _mm256_cvtpd_epi32(a);
+        __m128i b = _mm256_cvttpd_epi32(a);
         _mm_maskstore_epi32(pDst, sseTailMask32(len), b);
     }
 
@@ -76,7 +79,7 @@ namespace internals
         for (; pSrc < pEnd; pSrc += 8, pDst += 8)
         {
             __m256 a = avx_load_ps(pSrc);
-            __m256i b = _mm256_cvtps_epi32(a);
+            __m256i b = _mm256_cvttps_epi32(a);
             avx_store_si((__m256i*)pDst, b);
         }
 
@@ -134,13 +137,185 @@ namespace internals
 
         for (; pSrc < pEnd; pSrc += 4, pDst += 4) {
             __m256d a = avx_load_pd(pSrc);
-            __m128i b = _mm256_cvtpd_epi32(a);
+            __m128i b = _mm256_cvttpd_epi32(a);
             sse_store_si((__m128i*)pDst, b);
         }
 
         convertTail(pSrc, pDst, tail);
     }
 
+    /// One vector of _D per step from a 16, 8 or 4 byte load of _S
+    template <typename _S, typename _D, __m256i (*cvt)(__m128i)>
+    INLINE void widen(const _S * pSrc, _D * pDst, int len)
+    {
+        constexpr int step = 32 / sizeof(_D);
+        int tail = len % step;
+        const _S * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m128i a = sse_load_low<step * sizeof(_S)>(pSrc);
+            avx_store_si((__m256i*)pDst, cvt(a));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = (_D)pSrc[i];
+    }
+
+    /// Keeps the low half of every item, as a cast does. The pack works per 128-bit lane, the permute
+    /// puts the quarters back in order.
+    template <typename _S, typename _D, __m256i (*pack)(__m256i, __m256i)>
+    INLINE void narrow(const _S * pSrc, _D * pDst, int len)
+    {
+        constexpr int step = 32 / sizeof(_D);
+        int tail = len % step;
+        const _S * pEnd = pSrc + (len-tail);
+        const __m256i mask = (sizeof(_D) == 1) ? _mm256_set1_epi16(0xff) : _mm256_set1_epi32(0xffff);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m256i a = _mm256_and_si256(avx_load_si((const __m256i*)pSrc), mask);
+            __m256i b = _mm256_and_si256(avx_load_si((const __m256i*)pSrc + 1), mask);
+            __m256i c = pack(a, b);
+            avx_store_si((__m256i*)pDst, _mm256_permute4x64_epi64(c, _MM_SHUFFLE(3, 1, 2, 0)));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = (_D)pSrc[i];
+    }
+
+    /// Eight items of _S to float per step, times scale plus offset when scaled
+    template <typename _S, __m256i (*cvt)(__m128i), bool scaled>
+    INLINE void toFloat(const _S * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        int tail = len % 8;
+        const _S * pEnd = pSrc + (len-tail);
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 o = _mm256_set1_ps(offset);
+
+        for (; pSrc < pEnd; pSrc += 8, pDst += 8)
+        {
+            __m256 a = _mm256_cvtepi32_ps(cvt(sse_load_low<8 * sizeof(_S)>(pSrc)));
+            if (scaled)
+                a = _mm256_add_ps(_mm256_mul_ps(a, s), o);
+            avx_store_ps(pDst, a);
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = scaled ? (pSrc[i] * scale + offset) : pSrc[i];
+    }
+
+    template <bool scaled>
+    INLINE __m256i truncate(const float * pSrc, __m256 s, __m256 o, __m256i mask)
+    {
+        __m256 a = avx_load_ps(pSrc);
+        if (scaled)
+            a = _mm256_add_ps(_mm256_mul_ps(a, s), o);
+        return _mm256_and_si256(_mm256_cvttps_epi32(a), mask);
+    }
+
+    /// Float to 8 or 16 bit items, truncated as a cast does, 32 bytes of _D per step.
+    /// Packs interleave the 128-bit lanes, the permutes restore the order.
+    template <typename _D, bool scaled>
+    INLINE void fromFloat(const float * pSrc, _D * pDst, int len, float scale, float offset)
+    {
+        constexpr int step = 32 / sizeof(_D);
+        int tail = len % step;
+        const float * pEnd = pSrc + (len-tail);
+        const __m256 s = _mm256_set1_ps(scale);
+        const __m256 o = _mm256_set1_ps(offset);
+        const __m256i mask = _mm256_set1_epi32((sizeof(_D) == 1) ? 0xff : 0xffff);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m256i a = _mm256_packus_epi32(truncate<scaled>(pSrc, s, o, mask), truncate<scaled>(pSrc + 8, s, o, mask));
+            if (sizeof(_D) == 1)
+            {
+                __m256i b = _mm256_packus_epi32(truncate<scaled>(pSrc + 16, s, o, mask), truncate<scaled>(pSrc + 24, s, o, mask));
+                a = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(a, b), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            }
+            else
+                a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+            avx_store_si((__m256i*)pDst, a);
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = scaled ? (_D)(pSrc[i] * scale + offset) : (_D)pSrc[i];
+    }
+
+    /// Rounded by rnd, NaN as 0 and saturated to _D, in 32-bit lanes.
+    /// int32 overflow converts to 0x80000000, the xor turns it into INT_MAX on the positive side.
+    template <typename _D, int rnd>
+    INLINE __m256i roundSat(const float * pSrc, __m256 s)
+    {
+        __m256 a = _mm256_round_ps(_mm256_mul_ps(avx_load_ps(pSrc), s), rnd | _MM_FROUND_NO_EXC);
+        a = _mm256_and_ps(a, _mm256_cmp_ps(a, a, _CMP_ORD_Q));
+        if (sizeof(_D) == 4)
+        {
+            __m256i over = _mm256_castps_si256(_mm256_cmp_ps(a, _mm256_set1_ps(2147483648.f), _CMP_GE_OQ));
+            return _mm256_xor_si256(_mm256_cvttps_epi32(a), over);
+        }
+
+        a = _mm256_max_ps(a, _mm256_set1_ps(std::numeric_limits<_D>::min()));
+        a = _mm256_min_ps(a, _mm256_set1_ps(std::numeric_limits<_D>::max()));
+        return _mm256_cvttps_epi32(a);
+    }
+
+    /// Items are in range of _D before the packs, so signed and unsigned packs keep them as is.
+    /// Packs interleave the 128-bit lanes, the permutes restore the order.
+    template <typename _D, int rnd>
+    INLINE void convertSat(const float * pSrc, _D * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        constexpr int step = 32 / sizeof(_D);
+        constexpr bool sign = std::is_signed<_D>::value;
+        int tail = len % step;
+        const float * pEnd = pSrc + (len-tail);
+        const __m256 s = _mm256_set1_ps(std::ldexp(1.f, -scaleFactor));
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m256i a = roundSat<_D, rnd>(pSrc, s);
+            if (sizeof(_D) < 4)
+            {
+                __m256i b = roundSat<_D, rnd>(pSrc + 8, s);
+                a = sign ? _mm256_packs_epi32(a, b) : _mm256_packus_epi32(a, b);
+            }
+            if (sizeof(_D) == 1)
+            {
+                __m256i c = roundSat<_D, rnd>(pSrc + 16, s);
+                __m256i d = roundSat<_D, rnd>(pSrc + 24, s);
+                __m256i b = _mm256_packs_epi32(c, d);
+                a = sign ? _mm256_packs_epi16(a, b) : _mm256_packus_epi16(a, b);
+                a = _mm256_permutevar8x32_epi32(a, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+            }
+            else if (sizeof(_D) == 2)
+                a = _mm256_permute4x64_epi64(a, _MM_SHUFFLE(3, 1, 2, 0));
+            avx_store_si((__m256i*)pDst, a);
+        }
+
+        nosimd::common::convertSfs(pSrc, pDst, tail, mode, scaleFactor);
+    }
+
+    template <typename _D>
+    INLINE void convertSfs(const float * pSrc, _D * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        switch (mode)
+        {
+            case simd::RoundMode::Near:
+                convertSat<_D, _MM_FROUND_TO_NEAREST_INT>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Zero:
+                convertSat<_D, _MM_FROUND_TO_ZERO>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Down:
+                convertSat<_D, _MM_FROUND_TO_NEG_INF>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Up:
+                convertSat<_D, _MM_FROUND_TO_POS_INF>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+        }
+    }
+
 #if 0
     INLINE void convert_v2(const float * pSrc, double * pDst, int len)
     {
@@ -245,89 +420,197 @@ namespace common
 
     //
 
-    // TODO: 16 <-> float, 8 <-> float (convert + convert)
-    // TODO: 32 -> 16, 16 -> 8 _mm256_packs_epi*
+    // 8, 16 bit <-> float
+
+    _SIMD_SSE_SPEC void convert(const int8_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<int8_t, _mm256_cvtepi8_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, int8_t * pDst, int len)
+    {
+        internals::fromFloat<int8_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<uint8_t, _mm256_cvtepu8_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, uint8_t * pDst, int len)
+    {
+        internals::fromFloat<uint8_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int16_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<int16_t, _mm256_cvtepi16_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, int16_t * pDst, int len)
+    {
+        internals::fromFloat<int16_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<uint16_t, _mm256_cvtepu16_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, uint16_t * pDst, int len)
+    {
+        internals::fromFloat<uint16_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const int8_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<int8_t, _mm256_cvtepi8_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, int8_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<int8_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const uint8_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<uint8_t, _mm256_cvtepu8_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, uint8_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<uint8_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const int16_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<int16_t, _mm256_cvtepi16_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, int16_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<int16_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const uint16_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<uint16_t, _mm256_cvtepu16_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, uint16_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<uint16_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    // float -> 8, 16, 32 bit, rounded and saturated
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int8_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, uint8_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int16_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, uint16_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int32_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    //
 
     //
 
     _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int16_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int8_t, int16_t, _mm256_cvtepi8_epi16>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int32_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int8_t, int32_t, _mm256_cvtepi8_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int8_t, int64_t, _mm256_cvtepi8_epi64>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint16_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint8_t, uint16_t, _mm256_cvtepu8_epi16>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint32_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint8_t, uint32_t, _mm256_cvtepu8_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint8_t, uint64_t, _mm256_cvtepu8_epi64>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int8_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::narrow<int16_t, int8_t, _mm256_packus_epi16>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int32_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int16_t, int32_t, _mm256_cvtepi16_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int16_t, int64_t, _mm256_cvtepi16_epi64>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint8_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::narrow<uint16_t, uint8_t, _mm256_packus_epi16>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint32_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint16_t, uint32_t, _mm256_cvtepu16_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint16_t, uint64_t, _mm256_cvtepu16_epi64>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int32_t * pSrc, int16_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::narrow<int32_t, int16_t, _mm256_packus_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const int32_t * pSrc, int64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<int32_t, int64_t, _mm256_cvtepi32_epi64>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint32_t * pSrc, uint16_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::narrow<uint32_t, uint16_t, _mm256_packus_epi32>(pSrc, pDst, len);
     }
 
     _SIMD_SSE_SPEC void convert(const uint32_t * pSrc, uint64_t * pDst, int len)
     {
-        nosimd::common::convert(pSrc, pDst, len);
+        internals::widen<uint32_t, uint64_t, _mm256_cvtepu32_epi64>(pSrc, pDst, len);
     }
 }
 }
@@ -300,31 +300,37 @@ namespace statistical
 {
     _SIMD_SSE_SPEC void min(const double * pSrc, int len, double * pMin)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::min(pSrc, len, pMin);
     }
 
     _SIMD_SSE_SPEC void max(const double * pSrc, int len, double * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::max(pSrc, len, pMax);
     }
 
     _SIMD_SSE_SPEC void minMax(const double * pSrc, int len, double * pMin, double * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::minMax(pSrc, len, pMin, pMax);
     }
 
     _SIMD_SSE_SPEC void sum(const double * pSrc, int len, double * pSum)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::sum(pSrc, len, pSum);
     }
 
     _SIMD_SSE_SPEC void meanStdDev(const double * pSrc, int len, double * pMean, double * pStdDev)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
     }
 
     _SIMD_SSE_SPEC void dotProd(const double * pSrc1, const double * pSrc2, int len, double * pDp)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
     }
 }
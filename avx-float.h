@@ -300,31 +300,37 @@ namespace statistical
 {
     _SIMD_SSE_SPEC void min(const float * pSrc, int len, float * pMin)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::min(pSrc, len, pMin);
     }
 
     _SIMD_SSE_SPEC void max(const float * pSrc, int len, float * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::max(pSrc, len, pMax);
     }
 
     _SIMD_SSE_SPEC void minMax(const float * pSrc, int len, float * pMin, float * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::minMax(pSrc, len, pMin, pMax);
     }
 
     _SIMD_SSE_SPEC void sum(const float * pSrc, int len, float * pSum)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::sum(pSrc, len, pSum);
     }
 
     _SIMD_SSE_SPEC void meanStdDev(const float * pSrc, int len, float * pMean, float * pStdDev)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
     }
 
     _SIMD_SSE_SPEC void dotProd(const float * pSrc1, const float * pSrc2, int len, float * pDp)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
     }
 }
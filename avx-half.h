@@ -0,0 +1,181 @@
+#pragma once
+#include <immintrin.h>
+
+#include "sse.h"
+
+// F16C comes with every AVX2 CPU and CMake adds -mf16c to AVX builds. Without it float16_t stays scalar.
+
+namespace sse
+{
+namespace internals
+{
+    /// Eight 16-bit floats to float and back
+    template <typename _H> struct Half;
+
+#if defined(__F16C__)
+    template <> struct Half<simd::float16_t>
+    {
+        static INLINE __m256 toFloat(__m128i h) { return _mm256_cvtph_ps(h); }
+        static INLINE __m128i fromFloat(__m256 f) { return _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT); }
+    };
+#endif
+
+    template <> struct Half<simd::bfloat16_t>
+    {
+        static INLINE __m256 toFloat(__m128i h) { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16)); }
+
+        static INLINE __m128i fromFloat(__m256 f)
+        {
+            __m256i x = _mm256_castps_si256(f);
+            __m256i odd = _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+            __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(0x7fff)), odd), 16);
+            __m256i nan = _mm256_or_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(0x40));
+            r = _mm256_blendv_epi8(r, nan, _mm256_castps_si256(_mm256_cmp_ps(f, f, _CMP_UNORD_Q)));
+            return _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+        }
+    };
+
+    INLINE float horizontal_sum(__m256 x)
+    {
+        __m128 a = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+        a = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        return _mm_cvtss_f32(_mm_add_ss(a, _mm_shuffle_ps(a, a, 1)));
+    }
+
+    template <typename _H>
+    INLINE void halfToFloat(const _H * pSrc, float * pDst, int len)
+    {
+        int tail = len % 16;
+        const _H * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 16, pDst += 16)
+        {
+            avx_store_ps(pDst, Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc)));
+            avx_store_ps(pDst + 8, Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc + 1)));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = pSrc[i];
+    }
+
+    template <typename _H>
+    INLINE void floatToHalf(const float * pSrc, _H * pDst, int len)
+    {
+        int tail = len % 16;
+        const float * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 16, pDst += 16)
+        {
+            sse_store_si((__m128i*)pDst, Half<_H>::fromFloat(avx_load_ps(pSrc)));
+            sse_store_si((__m128i*)pDst + 1, Half<_H>::fromFloat(avx_load_ps(pSrc + 8)));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = pSrc[i];
+    }
+
+    template <typename _H>
+    INLINE void sumHalf(const _H * pSrc, int len, float * pSum)
+    {
+        int tail = len % 16;
+        const _H * pEnd = pSrc + (len-tail);
+        __m256 r0 = _mm256_setzero_ps();
+        __m256 r1 = _mm256_setzero_ps();
+
+        for (; pSrc < pEnd; pSrc += 16)
+        {
+            r0 = _mm256_add_ps(r0, Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc)));
+            r1 = _mm256_add_ps(r1, Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc + 1)));
+        }
+
+        float sum = horizontal_sum(_mm256_add_ps(r0, r1));
+        for (int i = 0; i < tail; ++i)
+            sum += pSrc[i];
+        *pSum = sum;
+    }
+
+    template <typename _H>
+    INLINE void dotProdHalf(const _H * pSrc1, const _H * pSrc2, int len, float * pDp)
+    {
+        int tail = len % 16;
+        const _H * pEnd = pSrc1 + (len-tail);
+        __m256 r0 = _mm256_setzero_ps();
+        __m256 r1 = _mm256_setzero_ps();
+
+        for (; pSrc1 < pEnd; pSrc1 += 16, pSrc2 += 16)
+        {
+            __m256 a0 = Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc1));
+            __m256 a1 = Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc1 + 1));
+            __m256 b0 = Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc2));
+            __m256 b1 = Half<_H>::toFloat(sse_load_si((const __m128i*)pSrc2 + 1));
+            r0 = _mm256_add_ps(r0, _mm256_mul_ps(a0, b0));
+            r1 = _mm256_add_ps(r1, _mm256_mul_ps(a1, b1));
+        }
+
+        float dp = horizontal_sum(_mm256_add_ps(r0, r1));
+        for (int i = 0; i < tail; ++i)
+            dp += float(pSrc1[i]) * float(pSrc2[i]);
+        *pDp = dp;
+    }
+}
+
+namespace common
+{
+#if defined(__F16C__)
+    _SIMD_SSE_SPEC void convert(const simd::float16_t * pSrc, float * pDst, int len)
+    {
+        internals::halfToFloat(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, simd::float16_t * pDst, int len)
+    {
+        internals::floatToHalf(pSrc, pDst, len);
+    }
+#endif
+
+    _SIMD_SSE_SPEC void convert(const simd::bfloat16_t * pSrc, float * pDst, int len)
+    {
+        internals::halfToFloat(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, simd::bfloat16_t * pDst, int len)
+    {
+        internals::floatToHalf(pSrc, pDst, len);
+    }
+}
+
+namespace statistical
+{
+    // 16-bit float storage, float accumulators
+
+    INLINE void sum(const simd::float16_t * pSrc, int len, float * pSum)
+    {
+#if defined(__F16C__)
+        internals::sumHalf(pSrc, len, pSum);
+#else
+        _SIMD_FALLBACK(len);
+        nosimd::statistical::sum(pSrc, len, pSum);
+#endif
+    }
+
+    INLINE void sum(const simd::bfloat16_t * pSrc, int len, float * pSum)
+    {
+        internals::sumHalf(pSrc, len, pSum);
+    }
+
+    INLINE void dotProd(const simd::float16_t * pSrc1, const simd::float16_t * pSrc2, int len, float * pDp)
+    {
+#if defined(__F16C__)
+        internals::dotProdHalf(pSrc1, pSrc2, len, pDp);
+#else
+        _SIMD_FALLBACK(len);
+        nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+#endif
+    }
+
+    INLINE void dotProd(const simd::bfloat16_t * pSrc1, const simd::bfloat16_t * pSrc2, int len, float * pDp)
+    {
+        internals::dotProdHalf(pSrc1, pSrc2, len, pDp);
+    }
+}
+}
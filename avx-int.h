@@ -357,6 +357,260 @@ namespace internals
         iPtrPtrDst<op>((const __m256i*)pSrc1, (const __m256i*)pSrc2, (__m256i*)pDst, (len>>5));
         _mm256_zeroall();
     }
+
+    // Multiplies without a native instruction
+
+    /// Low 8 bits of 8-bit products: 16-bit products of the even and of the odd bytes
+    INLINE __m256i mullo_epi8(__m256i a, __m256i b)
+    {
+        __m256i even = _mm256_mullo_epi16(a, b);
+        __m256i odd = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+        return _mm256_or_si256(_mm256_slli_epi16(odd, 8), _mm256_and_si256(even, _mm256_set1_epi16(0xff)));
+    }
+
+    /// Low 64 bits of 64-bit products: lo*lo + ((hi*lo + lo*hi) << 32)
+    INLINE __m256i mullo_epi64(__m256i a, __m256i b)
+    {
+        __m256i lo = _mm256_mul_epu32(a, b);
+        __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                         _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+        return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+    }
+
+    // Saturating ops. 8 and 16-bit add and sub are native.
+
+    INLINE __m256i sat_epi32(__m256i sign)
+    {
+        return _mm256_xor_si256(_mm256_srai_epi32(sign, 31), _mm256_set1_epi32(0x7fffffff));
+    }
+
+    INLINE __m256i adds_epi32(__m256i a, __m256i b)
+    {
+        __m256i s = _mm256_add_epi32(a, b);
+        __m256i over = _mm256_and_si256(_mm256_xor_si256(a, s), _mm256_xor_si256(b, s));
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(s), _mm256_castsi256_ps(sat_epi32(a)),
+                                                    _mm256_castsi256_ps(over)));
+    }
+
+    INLINE __m256i subs_epi32(__m256i a, __m256i b)
+    {
+        __m256i d = _mm256_sub_epi32(a, b);
+        __m256i over = _mm256_and_si256(_mm256_xor_si256(a, b), _mm256_xor_si256(a, d));
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(d), _mm256_castsi256_ps(sat_epi32(a)),
+                                                    _mm256_castsi256_ps(over)));
+    }
+
+    INLINE __m256i adds_epu32(__m256i a, __m256i b)
+    {
+        return _mm256_add_epi32(a, _mm256_min_epu32(b, _mm256_xor_si256(a, _mm256_set1_epi32(-1))));
+    }
+
+    INLINE __m256i subs_epu32(__m256i a, __m256i b)
+    {
+        return _mm256_sub_epi32(_mm256_max_epu32(a, b), b);
+    }
+
+    /// Low and high halves of the 64-bit products of 32-bit lanes
+    template <IntrAvxI::Binary mul>
+    INLINE __m256i mul_wide_epi32(__m256i a, __m256i b, __m256i& hi)
+    {
+        __m256i even = mul(a, b);
+        __m256i odd = mul(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        hi = _mm256_blend_epi16(_mm256_srli_epi64(even, 32), odd, 0xcc);
+        return _mm256_blend_epi16(even, _mm256_slli_epi64(odd, 32), 0xcc);
+    }
+
+    INLINE __m256i muls_epi32(__m256i a, __m256i b)
+    {
+        __m256i hi;
+        __m256i lo = mul_wide_epi32<_mm256_mul_epi32>(a, b, hi);
+        __m256i fits = _mm256_cmpeq_epi32(hi, _mm256_srai_epi32(lo, 31));
+        return _mm256_blendv_epi8(sat_epi32(_mm256_xor_si256(a, b)), lo, fits);
+    }
+
+    INLINE __m256i muls_epu32(__m256i a, __m256i b)
+    {
+        __m256i hi;
+        __m256i lo = mul_wide_epi32<_mm256_mul_epu32>(a, b, hi);
+        __m256i fits = _mm256_cmpeq_epi32(hi, _mm256_setzero_si256());
+        return _mm256_or_si256(lo, _mm256_xor_si256(fits, _mm256_set1_epi32(-1)));
+    }
+
+    // unpack and pack stay in 128-bit lanes: no permute
+
+    INLINE __m256i muls_epi16(__m256i a, __m256i b)
+    {
+        __m256i lo = _mm256_mullo_epi16(a, b);
+        __m256i hi = _mm256_mulhi_epi16(a, b);
+        return _mm256_packs_epi32(_mm256_unpacklo_epi16(lo, hi), _mm256_unpackhi_epi16(lo, hi));
+    }
+
+    INLINE __m256i muls_epu16(__m256i a, __m256i b)
+    {
+        __m256i lo = _mm256_mullo_epi16(a, b);
+        __m256i hi = _mm256_mulhi_epu16(a, b);
+        __m256i max = _mm256_set1_epi32(0xffff);
+        return _mm256_packus_epi32(_mm256_min_epu32(_mm256_unpacklo_epi16(lo, hi), max),
+                                   _mm256_min_epu32(_mm256_unpackhi_epi16(lo, hi), max));
+    }
+
+    INLINE __m256i muls_epi8(__m256i a, __m256i b)
+    {
+        __m256i lo = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpacklo_epi8(a, a), 8),
+                                        _mm256_srai_epi16(_mm256_unpacklo_epi8(b, b), 8));
+        __m256i hi = _mm256_mullo_epi16(_mm256_srai_epi16(_mm256_unpackhi_epi8(a, a), 8),
+                                        _mm256_srai_epi16(_mm256_unpackhi_epi8(b, b), 8));
+        return _mm256_packs_epi16(lo, hi);
+    }
+
+    INLINE __m256i muls_epu8(__m256i a, __m256i b)
+    {
+        __m256i zero = _mm256_setzero_si256();
+        __m256i max = _mm256_set1_epi16(0xff);
+        __m256i lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+        __m256i hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+        return _mm256_packus_epi16(_mm256_min_epu16(lo, max), _mm256_min_epu16(hi, max));
+    }
+
+    /// Scaled forms of 8 and 16-bit items: 8 items widened to 32-bit lanes, the shift of their exact result
+    /// and the saturating narrowing to _T. pack32 and pack16 work in 128-bit lanes, scaledBlock puts the items
+    /// back in order.
+    template <typename _T> struct SatI;
+
+    template <> struct SatI<int16_t>
+    {
+        static INLINE __m256i widen(const int16_t * p) { return _mm256_cvtepi16_epi32(sse_load_low<16>(p)); }
+        static INLINE __m256i shift(__m256i x, __m128i count) { return _mm256_sra_epi32(x, count); }
+        static INLINE __m256i pack32(__m256i a, __m256i b) { return _mm256_packs_epi32(a, b); }
+    };
+
+    template <> struct SatI<uint16_t>
+    {
+        static INLINE __m256i widen(const uint16_t * p) { return _mm256_cvtepu16_epi32(sse_load_low<16>(p)); }
+        static INLINE __m256i shift(__m256i x, __m128i count) { return _mm256_srl_epi32(x, count); }
+
+        static INLINE __m256i pack32(__m256i a, __m256i b)
+        {
+            __m256i max = _mm256_set1_epi32(0xffff);
+            return _mm256_packus_epi32(_mm256_min_epu32(a, max), _mm256_min_epu32(b, max));
+        }
+    };
+
+    template <> struct SatI<int8_t>
+    {
+        static INLINE __m256i widen(const int8_t * p) { return _mm256_cvtepi8_epi32(sse_load_low<8>(p)); }
+        static INLINE __m256i shift(__m256i x, __m128i count) { return _mm256_sra_epi32(x, count); }
+        static INLINE __m256i pack32(__m256i a, __m256i b) { return _mm256_packs_epi32(a, b); }
+        static INLINE __m256i pack16(__m256i a, __m256i b) { return _mm256_packs_epi16(a, b); }
+    };
+
+    template <> struct SatI<uint8_t>
+    {
+        static INLINE __m256i widen(const uint8_t * p) { return _mm256_cvtepu8_epi32(sse_load_low<8>(p)); }
+        static INLINE __m256i shift(__m256i x, __m128i count) { return _mm256_srl_epi32(x, count); }
+
+        static INLINE __m256i pack32(__m256i a, __m256i b)
+        {
+            __m256i max = _mm256_set1_epi32(0xff);
+            return _mm256_packus_epi32(_mm256_min_epu32(a, max), _mm256_min_epu32(b, max));
+        }
+
+        static INLINE __m256i pack16(__m256i a, __m256i b) { return _mm256_packus_epi16(a, b); }
+    };
+
+    /// Right shift by 1..30 rounding half to even
+    struct ScaleI
+    {
+        __m128i count;
+        __m256i mask;
+        __m256i half;
+
+        explicit ScaleI(int sf)
+        :   count(_mm_cvtsi32_si128(sf)),
+            mask(_mm256_set1_epi32((1 << sf) - 1)),
+            half(_mm256_set1_epi32(1 << (sf - 1)))
+        {}
+    };
+
+    template <typename _T, IntrAvxI::Binary op32>
+    INLINE __m256i scaledLanes(const _T * pSrc1, const _T * pSrc2, const ScaleI& s)
+    {
+        __m256i x = op32(SatI<_T>::widen(pSrc1), SatI<_T>::widen(pSrc2));
+        __m256i q = SatI<_T>::shift(x, s.count);
+        __m256i r = _mm256_add_epi32(_mm256_and_si256(x, s.mask), _mm256_and_si256(q, _mm256_set1_epi32(1)));
+        return _mm256_sub_epi32(q, _mm256_cmpgt_epi32(r, s.half));
+    }
+
+    template <typename _T, IntrAvxI::Binary op32>
+    INLINE __m256i scaledBlock(const _T * pSrc1, const _T * pSrc2, const ScaleI& s, std::integral_constant<int, 2>)
+    {
+        __m256i r = SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1, pSrc2, s),
+                                     scaledLanes<_T, op32>(pSrc1 + 8, pSrc2 + 8, s));
+        return _mm256_permute4x64_epi64(r, _MM_SHUFFLE(3, 1, 2, 0));
+    }
+
+    template <typename _T, IntrAvxI::Binary op32>
+    INLINE __m256i scaledBlock(const _T * pSrc1, const _T * pSrc2, const ScaleI& s, std::integral_constant<int, 1>)
+    {
+        __m256i lo = SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1, pSrc2, s),
+                                      scaledLanes<_T, op32>(pSrc1 + 8, pSrc2 + 8, s));
+        __m256i hi = SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1 + 16, pSrc2 + 16, s),
+                                      scaledLanes<_T, op32>(pSrc1 + 24, pSrc2 + 24, s));
+        return _mm256_permutevar8x32_epi32(SatI<_T>::pack16(lo, hi), _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+    }
+
+    template <typename _T>
+    using SatScalar = void (*)(const _T *, const _T *, _T *, int, int);
+
+    /// Without scaling: sat on whole registers, scalar tail
+    template <typename _T, IntrAvxI::Binary sat, SatScalar<_T> scalar>
+    INLINE void satPtrPtrDst(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+    {
+        int tail = len % avxBlockLen(_T());
+        len -= tail;
+        iPtrPtrDst<sat>((const __m256i*)pSrc1, (const __m256i*)pSrc2, (__m256i*)pDst, len / avxBlockLen(_T()));
+        _mm256_zeroall();
+        scalar(pSrc1 + len, pSrc2 + len, pDst + len, tail, 0);
+    }
+
+    /// 32-bit items: scaled results stay scalar
+    template <typename _T, IntrAvxI::Binary sat, SatScalar<_T> scalar>
+    INLINE void satSfs32(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+    {
+        if (scaleFactor == 0)
+            satPtrPtrDst<_T, sat, scalar>(pSrc1, pSrc2, pDst, len);
+        else
+        {
+            _SIMD_FALLBACK(len);
+            scalar(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+    }
+
+    /// 8 and 16-bit items: op32 on widened items for a scaleFactor in 1..30, scalar for other ones
+    template <typename _T, IntrAvxI::Binary sat, IntrAvxI::Binary op32, SatScalar<_T> scalar>
+    INLINE void satSfs(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+    {
+        if (scaleFactor == 0)
+            satPtrPtrDst<_T, sat, scalar>(pSrc1, pSrc2, pDst, len);
+        else if (scaleFactor > 0 && scaleFactor <= 30)
+        {
+            const int step = avxBlockLen(_T());
+            int tail = len % step;
+            len -= tail;
+
+            ScaleI s(scaleFactor);
+            for (int i = 0; i < len; i += step)
+                avx_store_si((__m256i*)(pDst + i), scaledBlock<_T, op32>(pSrc1 + i, pSrc2 + i, s,
+                                                                         std::integral_constant<int, sizeof(_T)>()));
+            _mm256_zeroall();
+            scalar(pSrc1 + len, pSrc2 + len, pDst + len, tail, scaleFactor);
+        }
+        else
+        {
+            _SIMD_FALLBACK(len);
+            scalar(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+    }
 }
 
 namespace common
@@ -475,6 +729,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
@@ -486,6 +741,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -507,6 +763,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -543,11 +800,13 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -573,6 +832,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -601,16 +861,18 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        internals::ptrValDst<internals::mullo_epi64>(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -627,16 +889,18 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        internals::ptrPtrDst<internals::mullo_epi64>(pSrc1, pSrc2, pDst, len);
     }
 
     _SIMD_SSE_SPEC void div(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
     _SIMD_SSE_SPEC void abs(const int64_t * pSrc, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::abs(pSrc, pDst, len);
     }
 
@@ -659,16 +923,18 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        mulC((const int64_t*)pSrc, (int64_t)val, (int64_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void divC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -685,11 +951,12 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        mul((const int64_t*)pSrc1, (const int64_t*)pSrc2, (int64_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void div(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -727,6 +994,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
@@ -741,6 +1009,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divCRev(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -771,6 +1040,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -810,11 +1080,13 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -840,6 +1112,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -869,11 +1142,15 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        internals::ptrValDst<internals::mullo_epi8>(pSrc, val, pDst, len);
+        int tail = len % avxBlockLen(*pDst);
+        len -= tail;
+        nosimd::arithmetic::mulC(pSrc+len, val, pDst+len, tail);
     }
 
     _SIMD_SSE_SPEC void divC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
@@ -888,6 +1165,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divCRev(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -910,11 +1188,15 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        internals::ptrPtrDst<internals::mullo_epi8>(pSrc1, pSrc2, pDst, len);
+        int tail = len % avxBlockLen(*pDst);
+        len -= tail;
+        nosimd::arithmetic::mul(pSrc1+len, pSrc2+len, pDst+len, tail);
     }
 
     _SIMD_SSE_SPEC void div(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -945,16 +1227,18 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        mulC((const int8_t*)pSrc, (int8_t)val, (int8_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void divC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -971,11 +1255,12 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        mul((const int8_t*)pSrc1, (const int8_t*)pSrc2, (int8_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void div(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -984,37 +1269,153 @@ namespace arithmetic
         if (pSrc != pDst)
             copy(pSrc, pDst, len);
     }
+
+    // saturating, scaled by 2^-scaleFactor
+
+    _SIMD_SSE_SPEC void addSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, _mm256_adds_epi8, _mm256_add_epi32, nosimd::arithmetic::addSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, _mm256_subs_epi8, _mm256_sub_epi32, nosimd::arithmetic::subSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, internals::muls_epi8, _mm256_mullo_epi32, nosimd::arithmetic::mulSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, _mm256_adds_epu8, _mm256_add_epi32, nosimd::arithmetic::addSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, _mm256_subs_epu8, internals::subs_epu32, nosimd::arithmetic::subSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, internals::muls_epu8, _mm256_mullo_epi32, nosimd::arithmetic::mulSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, _mm256_adds_epi16, _mm256_add_epi32, nosimd::arithmetic::addSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, _mm256_subs_epi16, _mm256_sub_epi32, nosimd::arithmetic::subSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, internals::muls_epi16, _mm256_mullo_epi32, nosimd::arithmetic::mulSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, _mm256_adds_epu16, _mm256_add_epi32, nosimd::arithmetic::addSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, _mm256_subs_epu16, internals::subs_epu32, nosimd::arithmetic::subSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, internals::muls_epu16, _mm256_mullo_epi32, nosimd::arithmetic::mulSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::adds_epi32, nosimd::arithmetic::addSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::subs_epi32, nosimd::arithmetic::subSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::muls_epi32, nosimd::arithmetic::mulSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::adds_epu32, nosimd::arithmetic::addSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::subs_epu32, nosimd::arithmetic::subSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::muls_epu32, nosimd::arithmetic::mulSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
 }
 
 namespace statistical
 {
     _SIMD_SSE_T void min(const _T * pSrc, int len, _T * pMin)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::min(pSrc, len, pMin);
     }
 
     _SIMD_SSE_T void max(const _T * pSrc, int len, _T * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::max(pSrc, len, pMax);
     }
 
     _SIMD_SSE_T void minMax(const _T * pSrc, int len, _T * pMin, _T * pMax)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::minMax(pSrc, len, pMin, pMax);
     }
 
     _SIMD_SSE_T void sum(const _T * pSrc, int len, _T * pSum)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::sum(pSrc, len, pSum);
     }
 
     _SIMD_SSE_T void meanStdDev(const _T * pSrc, int len, _T * pMean, _T * pStdDev)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
     }
 
     _SIMD_SSE_T void dotProd(const _T * pSrc1, const _T * pSrc2, int len, _T * pDp)
     {
+        _SIMD_FALLBACK(len);
         nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
     }
 }
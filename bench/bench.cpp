@@ -0,0 +1,667 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "simd.h"
+#include "counters.h"
+
+// Throughput of every op x item type x working set size for the backend simd.h picked in this build.
+// One binary per backend, see bench/CMakeLists.txt.
+//
+//   bench-sse [--json out.json] [--filter add] [--samples 9] [--min-time-ms 2]
+//
+// Regression check: record a baseline with --json, then run with --baseline. A case regresses when it is
+// slower by more than --tolerance (relative) and by more than --sigmas times the noise of both sides,
+// taken from the median absolute deviation of their samples. --runs repeats the whole sweep and keeps
+// the median of the runs, so drift between runs counts as noise too. Exit code 3 on regressions.
+//
+//   bench-sse --runs 5 --json base.json
+//   bench-sse --runs 5 --baseline base.json [--tolerance 0.1] [--sigmas 3]
+//
+// Hardware counters: --counters adds cycles, instructions, L1D and LLC misses per element, IPC and bytes per
+// cycle (Linux perf_event_open), --ports also uops per execution port (Skylake family event encoding).
+// The roofline columns put every case under the roof of its working set level: the best bytes per cycle
+// any op reached at that level, scaled by the op's elements per byte. Without counters cycles come from TSC.
+
+namespace
+{
+    const char * backendName()
+    {
+#if defined(NO_SIMD)
+        return "nosimd";
+#elif defined(SIMD_IPP)
+        return "ipp";
+#elif defined(SIMD_HYBRID)
+        return "hybrid";
+#elif defined(SIMD_OPENCL)
+        return "opencl";
+#elif defined(SIMD_AVX)
+        return "avx";
+#elif defined(UNROLL_MORE)
+        return "sse-unroll";
+#else
+        return "sse";
+#endif
+    }
+
+    template <typename T> const char * typeName();
+    template <> const char * typeName<uint8_t>() { return "8u"; }
+    template <> const char * typeName<int16_t>() { return "16s"; }
+    template <> const char * typeName<int32_t>() { return "32s"; }
+    template <> const char * typeName<int64_t>() { return "64s"; }
+    template <> const char * typeName<float>() { return "32f"; }
+    template <> const char * typeName<double>() { return "64f"; }
+
+    uint64_t cycles()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    struct Options
+    {
+        const char * json = nullptr;
+        const char * filter = nullptr;
+        const char * baseline = nullptr;
+        int samples = 9;
+        int runs = 1;
+        double minTime = 2e-3; // seconds per sample
+        double tolerance = 0.1;
+        double sigmas = 3;
+        bool counters = false;
+        bool ports = false;
+    };
+
+    /// Working set of one call, by the cache level it is meant to fit
+    struct Level
+    {
+        const char * name;
+        size_t bytes;
+    };
+
+    size_t cacheSize(int name, size_t fallback)
+    {
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+        long size = sysconf(name);
+        if (size > 0)
+            return size;
+#else
+        (void)name;
+#endif
+        return fallback;
+    }
+
+    // half of a cache leaves room for the rest of the process, DRAM is well past the last level
+    std::vector<Level> levels()
+    {
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+        size_t l1 = cacheSize(_SC_LEVEL1_DCACHE_SIZE, 32 << 10);
+        size_t l2 = cacheSize(_SC_LEVEL2_CACHE_SIZE, 1 << 20);
+        size_t llc = cacheSize(_SC_LEVEL3_CACHE_SIZE, l2 * 8);
+#else
+        size_t l1 = 32 << 10;
+        size_t l2 = 1 << 20;
+        size_t llc = 8 << 20;
+#endif
+        return {{"L1", l1 / 2}, {"L2", l2 / 2}, {"LLC", llc / 2}, {"DRAM", llc * 4}};
+    }
+
+    struct Result
+    {
+        std::string op;
+        const char * type;
+        const char * level;
+        int length;
+        size_t bytes;       // moved by one call
+        double seconds;     // median per call
+        double mad;         // median absolute deviation of the samples, seconds per call
+        double cv;          // standard deviation / mean of the samples
+        double elemPerCycle;
+        double ticks;       // TSC per call
+        double counts[bench::eventCount]; // per call, -1 if not counted
+    };
+
+    /// Core cycles per call when counted, TSC otherwise
+    double cyclesPerCall(const Result& r)
+    {
+        double counted = r.counts[int(bench::Event::Cycles)];
+        return (counted > 0) ? counted : r.ticks;
+    }
+
+    /// Samples of `reps` calls each, with reps grown until one sample takes minTime
+    Result measure(const Options& opts, bench::Counters * counters, const std::function<void()>& call, int length, size_t bytes)
+    {
+        call(); // warm up caches, lazy initialization and device programs
+
+        int reps = 1;
+        for (;;)
+        {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < reps; ++i)
+                call();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= opts.minTime || reps >= (1 << 24))
+                break;
+            reps *= 2;
+        }
+
+        std::vector<double> times;
+        std::vector<double> ticks;
+        if (counters)
+            counters->start();
+        for (int s = 0; s < opts.samples; ++s)
+        {
+            uint64_t c0 = cycles();
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < reps; ++i)
+                call();
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            uint64_t c1 = cycles();
+            times.push_back(elapsed.count() / reps);
+            ticks.push_back(double(c1 - c0) / reps);
+        }
+        if (counters)
+            counters->stop();
+
+        double mean = 0;
+        for (double t : times)
+            mean += t;
+        mean /= times.size();
+        double var = 0;
+        for (double t : times)
+            var += (t - mean) * (t - mean);
+        var /= times.size();
+
+        std::sort(times.begin(), times.end());
+        std::sort(ticks.begin(), ticks.end());
+        double median = times[times.size() / 2];
+        double medianTicks = ticks[ticks.size() / 2];
+
+        std::vector<double> deviations;
+        for (double t : times)
+            deviations.push_back(std::fabs(t - median));
+        std::sort(deviations.begin(), deviations.end());
+
+        Result r;
+        r.length = length;
+        r.bytes = bytes;
+        r.seconds = median;
+        r.mad = deviations[deviations.size() / 2];
+        r.cv = mean > 0 ? std::sqrt(var) / mean : 0;
+        r.elemPerCycle = medianTicks > 0 ? length / medianTicks : 0;
+        r.ticks = medianTicks;
+        for (int e = 0; e < bench::eventCount; ++e)
+            r.counts[e] = counters ? counters->perCall(bench::Event(e), uint64_t(reps) * opts.samples) : -1;
+        return r;
+    }
+
+    template <typename T>
+    std::shared_ptr<T> array(int len, T value)
+    {
+        std::shared_ptr<T> p(simd::malloc<T>(len), simd::free<T>);
+        simd::set(value, p.get(), len);
+        return p;
+    }
+
+    /// An op touching `arrays` arrays of T per element
+    struct Op
+    {
+        const char * name;
+        int arrays;
+    };
+
+    template <typename T>
+    class Bench
+    {
+    public:
+        Bench(const Options& opts, bench::Counters * counters, std::vector<Result>& results)
+        :   opts_(opts), counters_(counters), results_(results)
+        {}
+
+        void run(const Level& level)
+        {
+            level_ = &level;
+
+            T val = T(3);
+            T out = T(0);
+            int idx = 0;
+
+            op({"set", 1}, [&](T *, T *, T * c, int n) { simd::set(val, c, n); });
+            op({"copy", 2}, [&](T * a, T *, T * c, int n) { simd::copy(a, c, n); });
+            op({"addC", 2}, [&](T * a, T *, T * c, int n) { simd::addC(a, val, c, n); });
+            op({"add", 3}, [&](T * a, T * b, T * c, int n) { simd::add(a, b, c, n); });
+            op({"mulC", 2}, [&](T * a, T *, T * c, int n) { simd::mulC(a, val, c, n); });
+            op({"mul", 3}, [&](T * a, T * b, T * c, int n) { simd::mul(a, b, c, n); });
+            op({"div", 3}, [&](T * a, T * b, T * c, int n) { simd::div(a, b, c, n); });
+            op({"sum", 1}, [&](T * a, T *, T *, int n) { simd::sum(a, n, &out); });
+            op({"max", 1}, [&](T * a, T *, T *, int n) { simd::max(a, n, &out); });
+            op({"maxIndx", 1}, [&](T * a, T *, T *, int n) { simd::maxIndx(a, n, &out, &idx); });
+            op({"dotProd", 2}, [&](T * a, T * b, T *, int n) { simd::dotProd(a, b, n, &out); });
+            extra(out);
+        }
+
+    private:
+        const Options& opts_;
+        bench::Counters * counters_;
+        std::vector<Result>& results_;
+        const Level * level_ = nullptr;
+
+        template <typename _F>
+        void op(const Op& op, _F func)
+        {
+            if (opts_.filter && !strstr(op.name, opts_.filter))
+                return;
+
+            int len = std::max<int>(1, int(level_->bytes / (op.arrays * sizeof(T))));
+            auto a = array<T>(len, T(1));
+            auto b = array<T>(len, T(2));
+            auto c = array<T>(len, T(0));
+
+            Result r = measure(opts_, counters_, [&]() { func(a.get(), b.get(), c.get(), len); }, len, size_t(len) * op.arrays * sizeof(T));
+            r.op = op.name;
+            r.type = typeName<T>();
+            r.level = level_->name;
+            results_.push_back(r);
+        }
+
+        // float-only ops and kernel variants
+        void extra(T&) {}
+    };
+
+    template <>
+    void Bench<float>::extra(float& out)
+    {
+        op({"abs", 2}, [&](float * a, float *, float * c, int n) { simd::abs(a, c, n); });
+        op({"sqrt", 2}, [&](float * a, float *, float * c, int n) { simd::sqrt(a, c, n); });
+        op({"exp", 2}, [&](float * a, float *, float * c, int n) { simd::exp(a, c, n); });
+#if !defined(NO_SIMD) && !defined(SIMD_IPP) && !defined(SIMD_OPENCL) && !defined(SIMD_HYBRID) && !defined(SIMD_AVX)
+        // "TODO: perf tests" in sse-float.h: add-mul accumulators against _mm_dp_ps
+        op({"dotProd_v1", 2}, [&](float * a, float * b, float *, int n) { sse::statistical::dotProd_v1(a, b, n, &out); });
+        op({"dotProd_v2", 2}, [&](float * a, float * b, float *, int n) { sse::statistical::dotProd_v2(a, b, n, &out); });
+#else
+        (void)out;
+#endif
+    }
+
+    template <>
+    void Bench<double>::extra(double&)
+    {
+        op({"abs", 2}, [&](double * a, double *, double * c, int n) { simd::abs(a, c, n); });
+        op({"sqrt", 2}, [&](double * a, double *, double * c, int n) { simd::sqrt(a, c, n); });
+        op({"exp", 2}, [&](double * a, double *, double * c, int n) { simd::exp(a, c, n); });
+    }
+
+    template <typename T>
+    T median(std::vector<T> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v[v.size() / 2];
+    }
+
+    /// Every run holds the same cases in the same order
+    std::vector<Result> combine(const std::vector<std::vector<Result>>& runs)
+    {
+        std::vector<Result> results = runs[0];
+        if (runs.size() == 1)
+            return results;
+
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            std::vector<double> seconds, mads, cvs, rates, ticks;
+            std::vector<double> counts[bench::eventCount];
+            for (const std::vector<Result>& run : runs)
+            {
+                seconds.push_back(run[i].seconds);
+                mads.push_back(run[i].mad);
+                cvs.push_back(run[i].cv);
+                rates.push_back(run[i].elemPerCycle);
+                ticks.push_back(run[i].ticks);
+                for (int e = 0; e < bench::eventCount; ++e)
+                    counts[e].push_back(run[i].counts[e]);
+            }
+
+            Result& r = results[i];
+            r.seconds = median(seconds);
+            r.cv = median(cvs);
+            r.elemPerCycle = median(rates);
+            r.ticks = median(ticks);
+            for (int e = 0; e < bench::eventCount; ++e)
+                r.counts[e] = median(counts[e]);
+
+            std::vector<double> deviations;
+            for (double t : seconds)
+                deviations.push_back(std::fabs(t - r.seconds));
+            r.mad = std::max(median(deviations), median(mads));
+        }
+        return results;
+    }
+
+    void printTable(const std::vector<Result>& results)
+    {
+        printf("%-12s %-4s %-5s %10s %10s %9s %8s %6s\n", "op", "type", "level", "length", "ns/call", "GB/s", "elem/cyc", "cv%");
+        for (const Result& r : results)
+            printf("%-12s %-4s %-5s %10d %10.1f %9.2f %8.3f %6.2f\n", r.op.c_str(), r.type, r.level, r.length,
+                   r.seconds * 1e9, r.bytes / r.seconds * 1e-9, r.elemPerCycle, r.cv * 100);
+    }
+
+    /// Roof of a working set level: the best bytes per cycle of any op at that level
+    double roof(const std::vector<Result>& results, const char * level)
+    {
+        double best = 0;
+        for (const Result& r : results)
+            if (!strcmp(r.level, level) && cyclesPerCall(r) > 0)
+                best = std::max(best, r.bytes / cyclesPerCall(r));
+        return best;
+    }
+
+    /// Attainable elements per cycle under the roof of the case's level
+    double attainable(const Result& r, double roofBytes)
+    {
+        return roofBytes * r.length / r.bytes;
+    }
+
+    double perElement(const Result& r, bench::Event e)
+    {
+        double count = r.counts[int(e)];
+        return (count < 0) ? -1 : count / r.length;
+    }
+
+    void printCounters(const Options& opts, const std::vector<Result>& results)
+    {
+        printf("\n%-12s %-4s %-5s %8s %6s %7s %9s %9s %9s %9s %6s", "op", "type", "level", "cyc/el", "IPC", "B/cyc",
+               "L1miss/el", "LLCmis/el", "attain/cy", "elem/cyc", "roof%");
+        if (opts.ports)
+            for (int p = 0; p < bench::portCount; ++p)
+                printf(" %6s%d", "p", p);
+        printf("\n");
+
+        for (const Result& r : results)
+        {
+            double cycles = cyclesPerCall(r);
+            double instructions = r.counts[int(bench::Event::Instructions)];
+            double achieved = r.length / cycles;
+            double limit = attainable(r, roof(results, r.level));
+
+            printf("%-12s %-4s %-5s %8.3f", r.op.c_str(), r.type, r.level, cycles / r.length);
+            if (instructions >= 0 && r.counts[int(bench::Event::Cycles)] > 0)
+                printf(" %6.2f", instructions / cycles);
+            else
+                printf(" %6s", "n/a");
+            printf(" %7.2f", r.bytes / cycles);
+
+            for (bench::Event e : {bench::Event::L1Misses, bench::Event::LlcMisses})
+            {
+                if (perElement(r, e) >= 0)
+                    printf(" %9.4f", perElement(r, e));
+                else
+                    printf(" %9s", "n/a");
+            }
+            printf(" %9.3f %9.3f %6.1f", limit, achieved, limit > 0 ? achieved / limit * 100 : 0);
+
+            if (opts.ports)
+            {
+                for (int p = 0; p < bench::portCount; ++p)
+                {
+                    double uops = perElement(r, bench::Event(int(bench::Event::Port0) + p));
+                    if (uops >= 0)
+                        printf(" %7.3f", uops);
+                    else
+                        printf(" %7s", "n/a");
+                }
+            }
+            printf("\n");
+        }
+    }
+
+    bool writeJson(const char * path, const std::vector<Result>& results)
+    {
+        FILE * f = strcmp(path, "-") ? fopen(path, "w") : stdout;
+        if (!f)
+            return false;
+
+        fprintf(f, "{\n  \"backend\": \"%s\",\n  \"results\": [\n", backendName());
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& r = results[i];
+            double cycles = cyclesPerCall(r);
+            double limit = attainable(r, roof(results, r.level));
+            fprintf(f, "    {\"op\": \"%s\", \"type\": \"%s\", \"level\": \"%s\", \"length\": %d, \"bytes\": %zu, "
+                       "\"ns\": %.3f, \"mad_ns\": %.3f, \"gbps\": %.4f, \"elem_per_cycle\": %.5f, \"cv\": %.5f, "
+                       "\"bytes_per_cycle\": %.4f, \"attainable_elem_per_cycle\": %.5f",
+                    r.op.c_str(), r.type, r.level, r.length, r.bytes, r.seconds * 1e9, r.mad * 1e9,
+                    r.bytes / r.seconds * 1e-9, r.elemPerCycle, r.cv, r.bytes / cycles, limit);
+
+            double instructions = r.counts[int(bench::Event::Instructions)];
+            if (r.counts[int(bench::Event::Cycles)] > 0 && instructions >= 0)
+                fprintf(f, ", \"cycles\": %.2f, \"ipc\": %.4f", cycles, instructions / cycles);
+            if (r.counts[int(bench::Event::L1Misses)] >= 0)
+                fprintf(f, ", \"l1_misses_per_elem\": %.5f", perElement(r, bench::Event::L1Misses));
+            if (r.counts[int(bench::Event::LlcMisses)] >= 0)
+                fprintf(f, ", \"llc_misses_per_elem\": %.5f", perElement(r, bench::Event::LlcMisses));
+            if (r.counts[int(bench::Event::Port0)] >= 0)
+            {
+                fprintf(f, ", \"uops_per_elem_port\": [");
+                for (int p = 0; p < bench::portCount; ++p)
+                    fprintf(f, "%s%.4f", p ? ", " : "", perElement(r, bench::Event(int(bench::Event::Port0) + p)));
+                fprintf(f, "]");
+            }
+            fprintf(f, "}%s\n", (i + 1 < results.size()) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+
+        if (f != stdout)
+            fclose(f);
+        return true;
+    }
+
+    /// One case of a --json file. Times are per element: cache sizes, and so lengths, differ between machines.
+    struct Reference
+    {
+        std::string key;
+        double ns;
+        double madNs;
+    };
+
+    std::string key(const std::string& op, const std::string& type, const std::string& level)
+    {
+        return op + " " + type + " " + level;
+    }
+
+    // Reads what writeJson() writes, one result per line
+    std::string jsonString(const std::string& line, const char * name)
+    {
+        std::string tag = std::string("\"") + name + "\": \"";
+        size_t pos = line.find(tag);
+        if (pos == std::string::npos)
+            return std::string();
+        pos += tag.size();
+        return line.substr(pos, line.find('"', pos) - pos);
+    }
+
+    double jsonNumber(const std::string& line, const char * name)
+    {
+        std::string tag = std::string("\"") + name + "\": ";
+        size_t pos = line.find(tag);
+        return (pos == std::string::npos) ? -1 : atof(line.c_str() + pos + tag.size());
+    }
+
+    bool readBaseline(const char * path, std::string& backend, std::vector<Reference>& refs)
+    {
+        FILE * f = fopen(path, "r");
+        if (!f)
+            return false;
+
+        char buf[1024];
+        while (fgets(buf, sizeof(buf), f))
+        {
+            std::string line(buf);
+            if (backend.empty())
+                backend = jsonString(line, "backend");
+
+            double length = jsonNumber(line, "length");
+            double ns = jsonNumber(line, "ns");
+            if (line.find("\"op\"") == std::string::npos || length <= 0 || ns <= 0)
+                continue;
+
+            Reference ref;
+            ref.key = key(jsonString(line, "op"), jsonString(line, "type"), jsonString(line, "level"));
+            ref.ns = ns / length;
+            ref.madNs = std::max(jsonNumber(line, "mad_ns"), 0.) / length;
+            refs.push_back(ref);
+        }
+        fclose(f);
+        return true;
+    }
+
+    /// Returns the number of regressions
+    int compare(const Options& opts, const std::vector<Result>& results, const std::vector<Reference>& refs)
+    {
+        static constexpr double madToSigma = 1.4826; // for normally distributed noise
+
+        int regressions = 0;
+        printf("%-12s %-4s %-5s %12s %12s %8s\n", "op", "type", "level", "base ns/el", "now ns/el", "change");
+        for (const Result& r : results)
+        {
+            std::string k = key(r.op, r.type, r.level);
+            auto it = std::find_if(refs.begin(), refs.end(), [&k](const Reference& ref) { return ref.key == k; });
+            if (it == refs.end())
+                continue;
+
+            double now = r.seconds * 1e9 / r.length;
+            double nowMad = r.mad * 1e9 / r.length;
+            double noise = madToSigma * std::sqrt(nowMad * nowMad + it->madNs * it->madNs);
+            double change = now / it->ns - 1;
+
+            bool slower = (change > opts.tolerance) && (now - it->ns > opts.sigmas * noise);
+            regressions += slower;
+            printf("%-12s %-4s %-5s %12.4f %12.4f %+7.1f%%%s\n", r.op.c_str(), r.type, r.level, it->ns, now,
+                   change * 100, slower ? "  REGRESSION" : "");
+        }
+        return regressions;
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    Options opts;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = (i + 1 < argc);
+        if (!strcmp(argv[i], "--json") && hasValue)
+            opts.json = argv[++i];
+        else if (!strcmp(argv[i], "--filter") && hasValue)
+            opts.filter = argv[++i];
+        else if (!strcmp(argv[i], "--samples") && hasValue)
+            opts.samples = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--runs") && hasValue)
+            opts.runs = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--min-time-ms") && hasValue)
+            opts.minTime = std::max(0., atof(argv[++i])) * 1e-3;
+        else if (!strcmp(argv[i], "--baseline") && hasValue)
+            opts.baseline = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && hasValue)
+            opts.tolerance = std::max(0., atof(argv[++i]));
+        else if (!strcmp(argv[i], "--sigmas") && hasValue)
+            opts.sigmas = std::max(0., atof(argv[++i]));
+        else if (!strcmp(argv[i], "--counters"))
+            opts.counters = true;
+        else if (!strcmp(argv[i], "--ports"))
+            opts.counters = opts.ports = true;
+        else
+        {
+            fprintf(stderr, "usage: %s [--json file|-] [--filter op] [--samples n] [--runs n] [--min-time-ms t]"
+                            " [--baseline file] [--tolerance r] [--sigmas k] [--counters] [--ports]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Reference> refs;
+    std::string baseBackend;
+    if (opts.baseline && !readBaseline(opts.baseline, baseBackend, refs))
+    {
+        fprintf(stderr, "can't read %s\n", opts.baseline);
+        return 2;
+    }
+    if (opts.baseline && baseBackend != backendName())
+    {
+        fprintf(stderr, "%s is a %s baseline, this is %s\n", opts.baseline,
+                baseBackend.empty() ? "unknown" : baseBackend.c_str(), backendName());
+        return 2;
+    }
+
+    std::unique_ptr<bench::Counters> counters;
+    if (opts.counters)
+    {
+        counters.reset(new bench::Counters(opts.ports));
+        if (!counters->available())
+            fprintf(stderr, "no hardware counters (perf_event_open), using TSC cycles\n");
+    }
+
+    std::vector<std::vector<Result>> runs(opts.runs);
+    try
+    {
+        for (std::vector<Result>& run : runs)
+        {
+            for (const Level& level : levels())
+            {
+                Bench<float>(opts, counters.get(), run).run(level);
+                Bench<double>(opts, counters.get(), run).run(level);
+                Bench<int32_t>(opts, counters.get(), run).run(level);
+                Bench<int64_t>(opts, counters.get(), run).run(level);
+                Bench<int16_t>(opts, counters.get(), run).run(level);
+                Bench<uint8_t>(opts, counters.get(), run).run(level);
+            }
+        }
+    }
+    catch (const simd::Exception& ex)
+    {
+        fprintf(stderr, "%s:%u (%d) %s\n", ex.file(), ex.line(), ex.code(), ex.what());
+        return 1;
+    }
+
+    std::vector<Result> results = combine(runs);
+    if (opts.baseline)
+    {
+        int regressions = compare(opts, results, refs);
+        if (regressions)
+        {
+            fprintf(stderr, "%d regressions against %s\n", regressions, opts.baseline);
+            return 3;
+        }
+        return 0;
+    }
+
+    if (!opts.json || strcmp(opts.json, "-"))
+    {
+        printTable(results);
+        if (opts.counters)
+            printCounters(opts, results);
+    }
+    if (opts.json && !writeJson(opts.json, results))
+    {
+        fprintf(stderr, "can't write %s\n", opts.json);
+        return 1;
+    }
+    return 0;
+}
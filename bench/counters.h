@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Hardware counters around a benchmarked region, Linux perf_event_open only.
+// Every event is opened on its own, so the kernel multiplexes them when there are more events than counters
+// and counts are scaled by the time each event was actually scheduled. Events refused by the CPU, the kernel
+// or perf_event_paranoid (user space only needs <= 2) are reported as -1.
+
+namespace bench
+{
+    enum class Event
+    {
+        Cycles,
+        Instructions,
+        L1Misses,   // L1D read misses
+        LlcMisses,  // last level cache read misses
+        Port0,      // uops dispatched to port 0 .. 7, Skylake family encoding
+        Port1,
+        Port2,
+        Port3,
+        Port4,
+        Port5,
+        Port6,
+        Port7,
+        Count
+    };
+
+    static constexpr int eventCount = int(Event::Count);
+    static constexpr int portCount = 8;
+
+    class Counters
+    {
+    public:
+        explicit Counters(bool ports)
+        {
+            for (int i = 0; i < eventCount; ++i)
+            {
+                fds_[i] = -1;
+                counts_[i] = -1;
+            }
+#if defined(__linux__)
+            fds_[int(Event::Cycles)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            fds_[int(Event::Instructions)] = open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            fds_[int(Event::L1Misses)] = open(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D));
+            fds_[int(Event::LlcMisses)] = open(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_LL));
+
+            // UOPS_DISPATCHED_PORT.PORT_n: event 0xA1, umask 1 << n. Means something else on other cores.
+            if (ports)
+                for (int p = 0; p < portCount; ++p)
+                    fds_[int(Event::Port0) + p] = open(PERF_TYPE_RAW, 0xA1 | ((1u << p) << 8));
+#else
+            (void)ports;
+#endif
+        }
+
+        ~Counters()
+        {
+#if defined(__linux__)
+            for (int fd : fds_)
+                if (fd >= 0)
+                    close(fd);
+#endif
+        }
+
+        Counters(const Counters&) = delete;
+        Counters& operator = (const Counters&) = delete;
+
+        bool available() const { return fds_[int(Event::Cycles)] >= 0; }
+
+        void start()
+        {
+#if defined(__linux__)
+            for (int fd : fds_)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            for (int fd : fds_)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+        }
+
+        void stop()
+        {
+#if defined(__linux__)
+            for (int fd : fds_)
+                if (fd >= 0)
+                    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            for (int i = 0; i < eventCount; ++i)
+            {
+                counts_[i] = -1;
+                uint64_t data[3]; // value, time enabled, time running
+                if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != sizeof(data) || !data[2])
+                    continue;
+                counts_[i] = double(data[0]) * double(data[1]) / double(data[2]);
+            }
+#endif
+        }
+
+        /// Count per call between start() and stop(), -1 if the event is not counted
+        double perCall(Event e, uint64_t calls) const
+        {
+            double count = counts_[int(e)];
+            return (count < 0 || !calls) ? -1 : count / calls;
+        }
+
+    private:
+        int fds_[eventCount];
+        double counts_[eventCount];
+
+#if defined(__linux__)
+        static uint64_t cacheEvent(uint64_t cache)
+        {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        }
+
+        static int open(uint32_t type, uint64_t config)
+        {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            return int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+// Calls that end up in a scalar nosimd:: loop instead of a SIMD kernel. With -DSIMD_FALLBACK_REPORT every
+// fallback site counts its calls and elements, and logs each call when a log is set (or SIMD_FALLBACK_LOG is
+// in the environment). Without it _SIMD_FALLBACK(len) is empty.
+
+#if defined(SIMD_FALLBACK_REPORT)
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define _SIMD_FUNCTION __FUNCSIG__
+#else
+#define _SIMD_FUNCTION __PRETTY_FUNCTION__
+#endif
+
+namespace simd
+{
+    namespace fallback
+    {
+        /// One fallback site, i.e. one function and item type
+        struct Entry
+        {
+            std::string function;
+            uint64_t calls;
+            uint64_t elements;
+        };
+
+        namespace internals
+        {
+            class Site;
+
+            struct Registry
+            {
+                std::mutex lock;
+                std::vector<Site *> sites;
+                std::atomic<FILE *> log{getenv("SIMD_FALLBACK_LOG") ? stderr : nullptr};
+            };
+
+            inline Registry& registry()
+            {
+                static Registry r;
+                return r;
+            }
+
+            class Site
+            {
+            public:
+                explicit Site(const char * function)
+                :   function_(function)
+                {
+                    Registry& r = registry();
+                    std::lock_guard<std::mutex> lock(r.lock);
+                    r.sites.push_back(this);
+                }
+
+                void record(int len)
+                {
+                    uint64_t elements = (len > 0) ? uint64_t(len) : 0;
+                    calls_.fetch_add(1, std::memory_order_relaxed);
+                    elements_.fetch_add(elements, std::memory_order_relaxed);
+
+                    if (FILE * f = registry().log.load(std::memory_order_relaxed))
+                        fprintf(f, "simd fallback: %s len %d\n", function_, len);
+                }
+
+                Entry entry() const
+                {
+                    return Entry{function_, calls_.load(std::memory_order_relaxed), elements_.load(std::memory_order_relaxed)};
+                }
+
+                void reset()
+                {
+                    calls_.store(0, std::memory_order_relaxed);
+                    elements_.store(0, std::memory_order_relaxed);
+                }
+
+            private:
+                const char * function_;
+                std::atomic<uint64_t> calls_{0};
+                std::atomic<uint64_t> elements_{0};
+            };
+        }
+
+        /// Called sites, most elements first
+        inline std::vector<Entry> report()
+        {
+            internals::Registry& r = internals::registry();
+            std::vector<Entry> entries;
+            {
+                std::lock_guard<std::mutex> lock(r.lock);
+                for (const internals::Site * site : r.sites)
+                {
+                    Entry e = site->entry();
+                    if (e.calls)
+                        entries.push_back(e);
+                }
+            }
+
+            std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.elements > b.elements; });
+            return entries;
+        }
+
+        inline void reset()
+        {
+            internals::Registry& r = internals::registry();
+            std::lock_guard<std::mutex> lock(r.lock);
+            for (internals::Site * site : r.sites)
+                site->reset();
+        }
+
+        /// Logs every fallback call to f, nullptr stops logging
+        inline void setLog(FILE * f)
+        {
+            internals::registry().log = f;
+        }
+
+        inline void dump(FILE * f = stderr)
+        {
+            fprintf(f, "%14s %12s  %s\n", "elements", "calls", "function");
+            for (const Entry& e : report())
+                fprintf(f, "%14llu %12llu  %s\n", (unsigned long long)e.elements, (unsigned long long)e.calls, e.function.c_str());
+        }
+    }
+}
+
+#define _SIMD_FALLBACK(len) \
+    do { static simd::fallback::internals::Site _site(_SIMD_FUNCTION); _site.record(len); } while (0)
+#else
+#define _SIMD_FALLBACK(len) do {} while (0)
+#endif
@@ -0,0 +1,415 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "ocl.h"
+
+#if defined(SIMD_AVX)
+#include "avx-float.h"
+#include "avx-double.h"
+#include "avx-int.h"
+#include "avx-convert.h"
+#include "avx-half.h"
+#else
+#include "sse-float.h"
+#include "sse-double.h"
+#include "sse-int.h"
+#include "sse-convert.h"
+#include "sse-half.h"
+#endif
+
+/// CPU SIMD for short arrays, OpenCL for long ones. A call goes to the device once its source array
+/// is large enough to pay for launch latency and the bus transfers; the limits come from timing both
+/// sides on first use and can be replaced with setThresholds().
+namespace hybrid
+{
+    /// How a call loads the bus and the CPU: pSrc op val, pSrc1 op pSrc2, or a transcendental function
+    enum class Cost
+    {
+        Scalar,
+        Binary,
+        Math
+    };
+
+    /// Bytes of one source array from which a call runs on OpenCL. SIZE_MAX keeps the class on the CPU.
+    struct Thresholds
+    {
+        size_t scalar = SIZE_MAX;   // addC, mulC, abs, inv, sqrt, ...
+        size_t binary = SIZE_MAX;   // add, sub, mul, div
+        size_t math = SIZE_MAX;     // exp, ln, trigonometric, pow, cbrt, hypot
+    };
+
+    namespace internals
+    {
+        struct Routing
+        {
+            std::once_flag calibrated;
+            std::atomic<size_t> scalar{SIZE_MAX};
+            std::atomic<size_t> binary{SIZE_MAX};
+            std::atomic<size_t> math{SIZE_MAX};
+
+            void store(const Thresholds& t)
+            {
+                scalar = t.scalar;
+                binary = t.binary;
+                math = t.math;
+            }
+        };
+
+        inline Routing& routing()
+        {
+            static Routing r;
+            return r;
+        }
+
+        /// Best of a few runs, in seconds per source byte
+        template <typename _F>
+        inline double cpuCost(_F func, int len)
+        {
+            double best = 1e30;
+            for (int i = 0; i < 5; ++i)
+            {
+                auto start = std::chrono::steady_clock::now();
+                func();
+                std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                best = std::min(best, elapsed.count());
+            }
+            return best / (len * sizeof(float));
+        }
+
+        /// The device wins from latency / (cpu - transfer) bytes on, or never if its transfers alone are slower
+        inline size_t breakEven(double latency, double cpuPerByte, double busPerByte)
+        {
+            if (cpuPerByte <= busPerByte)
+                return SIZE_MAX;
+            double bytes = latency / (cpuPerByte - busPerByte);
+            return bytes < double(SIZE_MAX / 2) ? size_t(bytes) : SIZE_MAX;
+        }
+
+        inline Thresholds measure()
+        {
+            Thresholds t;
+            ocl::TransferCost dev;
+            try
+            {
+                dev = ocl::measureTransferCost();
+            }
+            catch (const simd::Exception&)
+            {
+                return t; // no device: everything stays on the CPU
+            }
+
+            static constexpr int len = 1 << 16;
+            std::vector<float> a(len, 1.f), b(len, 2.f), c(len);
+            double scalar = cpuCost([&]() { sse::arithmetic::mulC(a.data(), 3.f, c.data(), len); }, len);
+            double binary = cpuCost([&]() { sse::arithmetic::mul(a.data(), b.data(), c.data(), len); }, len);
+            double math = cpuCost([&]() { nosimd::exp_log::exp(a.data(), c.data(), len); }, len);
+
+            // source bytes cross the bus with the destination: twice for one source, three times for two
+            double busPerByte = 1. / dev.bytesPerSecond;
+            t.scalar = breakEven(dev.latency, scalar, 2 * busPerByte);
+            t.binary = breakEven(dev.latency, binary, 3 * busPerByte);
+            t.math = breakEven(dev.latency, math, 2 * busPerByte);
+            return t;
+        }
+
+        inline size_t threshold(Cost cost)
+        {
+            Routing& r = routing();
+            std::call_once(r.calibrated, [&r]() { r.store(measure()); });
+            switch (cost)
+            {
+                case Cost::Scalar: return r.scalar;
+                case Cost::Binary: return r.binary;
+                case Cost::Math: return r.math;
+            }
+            return SIZE_MAX;
+        }
+
+        template <typename _T>
+        inline bool offload(Cost cost, int len)
+        {
+            return len > 0 && size_t(len) * sizeof(_T) >= threshold(cost);
+        }
+    }
+
+    /// Current limits; the first call measures them
+    inline Thresholds thresholds()
+    {
+        Thresholds t;
+        t.scalar = internals::threshold(Cost::Scalar);
+        t.binary = internals::threshold(Cost::Binary);
+        t.math = internals::threshold(Cost::Math);
+        return t;
+    }
+
+    /// Replaces the limits. Set before the first routed call, it also skips the measurement.
+    inline void setThresholds(const Thresholds& t)
+    {
+        internals::Routing& r = internals::routing();
+        std::call_once(r.calibrated, []() {});
+        r.store(t);
+    }
+
+    /// Measures again, e.g. after switching the current OpenCL context
+    inline Thresholds calibrate()
+    {
+        Thresholds t = internals::measure();
+        setThresholds(t);
+        return t;
+    }
+
+    namespace common
+    {
+        // page aligned: the device maps them without copies, SIMD loads stay aligned
+        using ocl::common::malloc;
+        using ocl::common::free;
+
+        using sse::common::set;
+        using sse::common::copy;
+        using sse::common::zero;
+        using sse::common::move;
+        using sse::common::convert;
+        using sse::common::convertScale;
+        using sse::common::convertSfs;
+    }
+
+    namespace arithmetic
+    {
+        template<typename _T> inline void addC(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::addC(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::addC(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void add(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Binary, len))
+                ocl::arithmetic::add(pSrc1, pSrc2, pDst, len);
+            else
+                sse::arithmetic::add(pSrc1, pSrc2, pDst, len);
+        }
+
+        template<typename _T> inline void subC(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::subC(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::subC(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void subCRev(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::subCRev(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::subCRev(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void sub(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Binary, len))
+                ocl::arithmetic::sub(pSrc1, pSrc2, pDst, len);
+            else
+                sse::arithmetic::sub(pSrc1, pSrc2, pDst, len);
+        }
+
+        template<typename _T> inline void mulC(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::mulC(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::mulC(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void mul(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Binary, len))
+                ocl::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+            else
+                sse::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        }
+
+        template<typename _T> inline void divC(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::divC(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::divC(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void divCRev(const _T* pSrc, _T val, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::divCRev(pSrc, val, pDst, len);
+            else
+                sse::arithmetic::divCRev(pSrc, val, pDst, len);
+        }
+
+        template<typename _T> inline void div(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Binary, len))
+                ocl::arithmetic::div(pSrc1, pSrc2, pDst, len);
+            else
+                sse::arithmetic::div(pSrc1, pSrc2, pDst, len);
+        }
+
+        template<typename _T> inline void abs(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::arithmetic::abs(pSrc, pDst, len);
+            else
+                sse::arithmetic::abs(pSrc, pDst, len);
+        }
+
+        using sse::arithmetic::addSat;
+        using sse::arithmetic::subSat;
+        using sse::arithmetic::mulSat;
+        using sse::arithmetic::addSfs;
+        using sse::arithmetic::subSfs;
+        using sse::arithmetic::mulSfs;
+    }
+
+    namespace power
+    {
+        template<typename _T> inline void inv(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::power::inv(pSrc, pDst, len);
+            else
+                sse::power::inv(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void sqrt(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::power::sqrt(pSrc, pDst, len);
+            else
+                sse::power::sqrt(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void invSqrt(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Scalar, len))
+                ocl::power::invSqrt(pSrc, pDst, len);
+            else
+                sse::power::invSqrt(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void cbrt(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::power::cbrt(pSrc, pDst, len);
+            else
+                sse::power::cbrt(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void powx(const _T* pSrc, const _T constValue, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::power::powx(pSrc, constValue, pDst, len);
+            else
+                sse::power::powx(pSrc, constValue, pDst, len);
+        }
+
+        template<typename _T> inline void pow(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::power::pow(pSrc1, pSrc2, pDst, len);
+            else
+                sse::power::pow(pSrc1, pSrc2, pDst, len);
+        }
+
+        template<typename _T> inline void hypot(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::power::hypot(pSrc1, pSrc2, pDst, len);
+            else
+                sse::power::hypot(pSrc1, pSrc2, pDst, len);
+        }
+    }
+
+    namespace exp_log
+    {
+        template<typename _T> inline void exp(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::exp_log::exp(pSrc, pDst, len);
+            else
+                sse::exp_log::exp(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void ln(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::exp_log::ln(pSrc, pDst, len);
+            else
+                sse::exp_log::ln(pSrc, pDst, len);
+        }
+    }
+
+    namespace trigonometric
+    {
+        template<typename _T> inline void sin(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::sin(pSrc, pDst, len);
+            else
+                sse::trigonometric::sin(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void cos(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::cos(pSrc, pDst, len);
+            else
+                sse::trigonometric::cos(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void tan(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::tan(pSrc, pDst, len);
+            else
+                sse::trigonometric::tan(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void asin(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::asin(pSrc, pDst, len);
+            else
+                sse::trigonometric::asin(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void acos(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::acos(pSrc, pDst, len);
+            else
+                sse::trigonometric::acos(pSrc, pDst, len);
+        }
+
+        template<typename _T> inline void atan(const _T* pSrc, _T* pDst, int len)
+        {
+            if (internals::offload<_T>(Cost::Math, len))
+                ocl::trigonometric::atan(pSrc, pDst, len);
+            else
+                sse::trigonometric::atan(pSrc, pDst, len);
+        }
+    }
+
+    using namespace hybrid::common;
+    using namespace hybrid::arithmetic;
+    using namespace hybrid::power;
+    using namespace hybrid::exp_log;
+    using namespace hybrid::trigonometric;
+
+    using namespace sse::compare;
+    using namespace sse::statistical;
+}
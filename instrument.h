@@ -0,0 +1,345 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/// Call counts, log2 length histograms, elements and cycles per function and item type, for builds with
+/// -DSIMD_INSTRUMENT. simd.h then binds the backend to simd_backend and simd:: resolves through the wrappers
+/// below; functions without a wrapper fall through to the backend. Counters are per thread and only written
+/// by their thread, snapshot() sums every live and finished thread.
+namespace instrument
+{
+    using namespace simd_backend;
+
+    /// Wrapped functions and the position of their length argument, -1 for the last one
+#define _SIMD_INSTRUMENT_COMPARE(F) \
+    F(find, 2) F(findNot, 2) F(findSame, 2) F(findDiff, 2)
+
+#if defined(SIMD_IPP)
+#define _SIMD_INSTRUMENT_COMPARE_LIST(F)
+#else
+#define _SIMD_INSTRUMENT_COMPARE_LIST(F) _SIMD_INSTRUMENT_COMPARE(F)
+#endif
+
+#define _SIMD_INSTRUMENT_LIST(F) \
+    F(zero, -1) F(set, -1) F(copy, -1) F(move, -1) F(convert, -1) F(convertScale, 2) F(convertSfs, 2) \
+    _SIMD_INSTRUMENT_COMPARE_LIST(F) \
+    F(addC, -1) F(add, -1) F(subC, -1) F(subCRev, -1) F(sub, -1) \
+    F(mulC, -1) F(mul, -1) F(divC, -1) F(divCRev, -1) F(div, -1) F(abs, -1) \
+    F(addSat, -1) F(subSat, -1) F(mulSat, -1) F(addSfs, 3) F(subSfs, 3) F(mulSfs, 3) \
+    F(inv, -1) F(sqrt, -1) F(invSqrt, -1) F(powx, -1) F(pow, -1) F(cbrt, -1) F(hypot, -1) \
+    F(exp, -1) F(ln, -1) \
+    F(sin, -1) F(cos, -1) F(tan, -1) F(asin, -1) F(acos, -1) F(atan, -1) \
+    F(max, 1) F(maxIndx, 1) F(min, 1) F(minIndx, 1) F(minMax, 1) F(minMaxIndx, 1) \
+    F(sum, 1) F(mean, 1) F(stdDev, 1) F(meanStdDev, 1) F(normInf, 1) F(normL1, 1) F(normL2, 1) \
+    F(normDiffInf, 2) F(normDiffL1, 2) F(normDiffL2, 2) F(dotProd, 2)
+
+    enum class Func
+    {
+#define _SIMD_INSTRUMENT_ENUM(name, pos) name,
+        _SIMD_INSTRUMENT_LIST(_SIMD_INSTRUMENT_ENUM)
+#undef _SIMD_INSTRUMENT_ENUM
+        Count
+    };
+
+    static constexpr int funcCount = int(Func::Count);
+    static constexpr int typeCount = 13;        // 8u .. 64f, 16f, bf16, then anything else
+    static constexpr int histogramSize = 32;    // bucket b holds lengths in [2^(b-1), 2^b), 0 holds 0
+
+    inline const char * funcName(Func f)
+    {
+        static const char * names[] = {
+#define _SIMD_INSTRUMENT_NAME(name, pos) #name,
+            _SIMD_INSTRUMENT_LIST(_SIMD_INSTRUMENT_NAME)
+#undef _SIMD_INSTRUMENT_NAME
+        };
+        return names[int(f)];
+    }
+
+    inline const char * typeName(int type)
+    {
+        static const char * names[typeCount] = {"8u", "8s", "16u", "16s", "32u", "32s", "64u", "64s", "32f", "64f", "16f", "bf16", "?"};
+        return names[type];
+    }
+
+    /// One function and item type, summed over threads
+    struct Entry
+    {
+        Func func;
+        int type;
+        uint64_t calls;
+        uint64_t elements;
+        uint64_t cycles;
+        uint64_t histogram[histogramSize];
+    };
+
+    namespace internals
+    {
+        struct Counter
+        {
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> elements{0};
+            std::atomic<uint64_t> cycles{0};
+            std::atomic<uint64_t> histogram[histogramSize] = {};
+        };
+
+        struct Table
+        {
+            Counter counters[funcCount][typeCount];
+        };
+
+        /// Single writer: no locked instruction on the hot path
+        inline void bump(std::atomic<uint64_t>& c, uint64_t value)
+        {
+            c.store(c.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        inline void add(Table& dst, const Table& src)
+        {
+            for (int f = 0; f < funcCount; ++f)
+            {
+                for (int t = 0; t < typeCount; ++t)
+                {
+                    Counter& d = dst.counters[f][t];
+                    const Counter& s = src.counters[f][t];
+                    bump(d.calls, s.calls.load(std::memory_order_relaxed));
+                    bump(d.elements, s.elements.load(std::memory_order_relaxed));
+                    bump(d.cycles, s.cycles.load(std::memory_order_relaxed));
+                    for (int b = 0; b < histogramSize; ++b)
+                        bump(d.histogram[b], s.histogram[b].load(std::memory_order_relaxed));
+                }
+            }
+        }
+
+        inline void clear(Table& table)
+        {
+            for (auto& row : table.counters)
+            {
+                for (Counter& c : row)
+                {
+                    c.calls.store(0, std::memory_order_relaxed);
+                    c.elements.store(0, std::memory_order_relaxed);
+                    c.cycles.store(0, std::memory_order_relaxed);
+                    for (auto& h : c.histogram)
+                        h.store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// Tables of running threads and the sum of the finished ones
+        struct Registry
+        {
+            std::mutex lock;
+            std::vector<Table *> live;
+            Table retired;
+        };
+
+        inline Registry& registry()
+        {
+            static Registry r;
+            return r;
+        }
+
+        class ThreadTable
+        {
+        public:
+            ThreadTable()
+            :   table_(new Table)
+            {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.lock);
+                r.live.push_back(table_.get());
+            }
+
+            ~ThreadTable()
+            {
+                Registry& r = registry();
+                std::lock_guard<std::mutex> lock(r.lock);
+                add(r.retired, *table_);
+                for (size_t i = 0; i < r.live.size(); ++i)
+                {
+                    if (r.live[i] == table_.get())
+                    {
+                        r.live.erase(r.live.begin() + i);
+                        break;
+                    }
+                }
+            }
+
+            Table& table() { return *table_; }
+
+        private:
+            std::unique_ptr<Table> table_;
+        };
+
+        inline Table& local()
+        {
+            thread_local ThreadTable t;
+            return t.table();
+        }
+
+        inline uint64_t ticks()
+        {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+        }
+
+        inline int bucket(uint64_t len)
+        {
+            int b = 0;
+            while (len && b < histogramSize - 1)
+            {
+                len >>= 1;
+                ++b;
+            }
+            return b;
+        }
+
+        template <typename _T> inline int typeIndex()
+        {
+            using std::is_same;
+            return is_same<_T, uint8_t>::value ? 0 : is_same<_T, int8_t>::value ? 1 :
+                is_same<_T, uint16_t>::value ? 2 : is_same<_T, int16_t>::value ? 3 :
+                is_same<_T, uint32_t>::value ? 4 : is_same<_T, int32_t>::value ? 5 :
+                is_same<_T, uint64_t>::value ? 6 : is_same<_T, int64_t>::value ? 7 :
+                is_same<_T, float>::value ? 8 : is_same<_T, double>::value ? 9 :
+                is_same<_T, simd::float16_t>::value ? 10 : is_same<_T, simd::bfloat16_t>::value ? 11 : 12;
+        }
+
+        /// Item type of a call: the first argument is the source array, or the value set()
+        template <typename _A, typename... _Args> inline int typeOf()
+        {
+            return typeIndex<std::remove_cv_t<std::remove_pointer_t<std::decay_t<_A>>>>();
+        }
+
+        template <typename _T>
+        inline std::enable_if_t<std::is_integral<_T>::value, uint64_t> lengthOf(const _T& len)
+        {
+            return (len > 0) ? uint64_t(len) : 0;
+        }
+
+        // device arrays and anything else without an int length
+        template <typename _T>
+        inline std::enable_if_t<!std::is_integral<_T>::value, uint64_t> lengthOf(const _T&)
+        {
+            return 0;
+        }
+
+        template <int _Pos, typename... _Args>
+        inline uint64_t lengthArg(const _Args&... args)
+        {
+            constexpr int pos = (_Pos < 0) ? int(sizeof...(_Args)) + _Pos : _Pos;
+            return lengthOf(std::get<pos>(std::forward_as_tuple(args...)));
+        }
+
+        class Probe
+        {
+        public:
+            Probe(Func func, int type, uint64_t len)
+            :   counter_(local().counters[int(func)][type]), len_(len), start_(ticks())
+            {}
+
+            ~Probe()
+            {
+                uint64_t elapsed = ticks() - start_;
+                bump(counter_.calls, 1);
+                bump(counter_.elements, len_);
+                bump(counter_.cycles, elapsed);
+                bump(counter_.histogram[bucket(len_)], 1);
+            }
+
+        private:
+            Counter& counter_;
+            uint64_t len_;
+            uint64_t start_;
+        };
+    }
+
+#define _SIMD_INSTRUMENT_WRAP(name, pos) \
+    template <typename... _Args> \
+    inline decltype(auto) name(_Args&&... args) \
+    { \
+        internals::Probe probe(Func::name, internals::typeOf<_Args...>(), internals::lengthArg<pos>(args...)); \
+        return simd_backend::name(std::forward<_Args>(args)...); \
+    }
+
+    _SIMD_INSTRUMENT_LIST(_SIMD_INSTRUMENT_WRAP)
+#undef _SIMD_INSTRUMENT_WRAP
+
+    /// Called entries summed over all threads, running and finished
+    inline std::vector<Entry> snapshot()
+    {
+        internals::Registry& r = internals::registry();
+        std::lock_guard<std::mutex> lock(r.lock);
+
+        std::unique_ptr<internals::Table> sum(new internals::Table);
+        internals::add(*sum, r.retired);
+        for (const internals::Table * table : r.live)
+            internals::add(*sum, *table);
+
+        std::vector<Entry> entries;
+        for (int f = 0; f < funcCount; ++f)
+        {
+            for (int t = 0; t < typeCount; ++t)
+            {
+                const internals::Counter& c = sum->counters[f][t];
+                if (!c.calls)
+                    continue;
+
+                Entry e;
+                e.func = Func(f);
+                e.type = t;
+                e.calls = c.calls;
+                e.elements = c.elements;
+                e.cycles = c.cycles;
+                for (int b = 0; b < histogramSize; ++b)
+                    e.histogram[b] = c.histogram[b];
+                entries.push_back(e);
+            }
+        }
+        return entries;
+    }
+
+    /// Zeroes all counters. A call running on another thread meanwhile may keep its old count.
+    inline void reset()
+    {
+        internals::Registry& r = internals::registry();
+        std::lock_guard<std::mutex> lock(r.lock);
+        internals::clear(r.retired);
+        for (internals::Table * table : r.live)
+            internals::clear(*table);
+    }
+
+    /// Table of snapshot(), histogram buckets as "2^b:calls" for lengths below 2^b
+    inline void dump(FILE * f = stderr)
+    {
+        fprintf(f, "%-12s %-4s %12s %14s %16s %9s  %s\n", "function", "type", "calls", "elements", "cycles", "cyc/elem",
+                "lengths");
+        for (const Entry& e : snapshot())
+        {
+            fprintf(f, "%-12s %-4s %12llu %14llu %16llu %9.3f ", funcName(e.func), typeName(e.type),
+                    (unsigned long long)e.calls, (unsigned long long)e.elements, (unsigned long long)e.cycles,
+                    e.elements ? double(e.cycles) / e.elements : 0.);
+            for (int b = 0; b < histogramSize; ++b)
+                if (e.histogram[b])
+                    fprintf(f, " 2^%d:%llu", b, (unsigned long long)e.histogram[b]);
+            fprintf(f, "\n");
+        }
+    }
+}
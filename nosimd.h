@@ -1,8 +1,11 @@
 #pragma once
 #include <cstdint>
 #include <cmath>
+#include <cstring>
 #include <exception>
+#include <limits>
 #include <string>
+#include <type_traits>
 
 namespace simd
 {
@@ -30,6 +33,99 @@ namespace simd
         int32_t errorCode_;
         std::string what_;
     };
+
+    /// IEEE 754 binary16 storage: arithmetic goes through float, narrowing rounds to nearest even
+    struct float16_t
+    {
+        uint16_t bits;
+
+        float16_t() = default;
+        float16_t(float f) : bits(fromFloat(f)) {}
+        operator float() const { return toFloat(bits); }
+
+        static uint16_t fromFloat(float f)
+        {
+            uint32_t x;
+            memcpy(&x, &f, sizeof(x));
+            uint32_t sign = (x >> 16) & 0x8000;
+            x &= 0x7fffffff;
+
+            if (x > 0x7f800000) // NaN keeps the top of its payload and turns quiet
+                return sign | 0x7e00 | ((x >> 13) & 0x3ff);
+            if (x >= 0x477ff000) // 65520 and above round to inf
+                return sign | 0x7c00;
+            if (x < 0x38800000) // below 2^-14: 0.5f has the ulp of a half subnormal, the FPU rounds
+            {
+                float a;
+                memcpy(&a, &x, sizeof(a));
+                a += 0.5f;
+                memcpy(&x, &a, sizeof(x));
+                return sign | (x - 0x3f000000);
+            }
+
+            // rebias the exponent, round half to even on the 13 dropped bits
+            x += 0xc8000fff + ((x >> 13) & 1);
+            return sign | (x >> 13);
+        }
+
+        static float toFloat(uint16_t h)
+        {
+            uint32_t sign = uint32_t(h & 0x8000) << 16;
+            uint32_t exp = (h >> 10) & 0x1f;
+            uint32_t mant = h & 0x3ff;
+            uint32_t x;
+
+            if (exp == 0x1f)
+                x = sign | 0x7f800000 | (mant << 13);
+            else if (exp)
+                x = sign | ((exp + 112) << 23) | (mant << 13);
+            else
+            {
+                float f = std::ldexp(float(mant), -24);
+                return sign ? -f : f;
+            }
+
+            float f;
+            memcpy(&f, &x, sizeof(f));
+            return f;
+        }
+    };
+
+    /// bfloat16 storage, the top half of a float: arithmetic goes through float, narrowing rounds to nearest even
+    struct bfloat16_t
+    {
+        uint16_t bits;
+
+        bfloat16_t() = default;
+        bfloat16_t(float f) : bits(fromFloat(f)) {}
+        operator float() const { return toFloat(bits); }
+
+        static uint16_t fromFloat(float f)
+        {
+            uint32_t x;
+            memcpy(&x, &f, sizeof(x));
+            if ((x & 0x7fffffff) > 0x7f800000)
+                return (x >> 16) | 0x40;
+            return (x + 0x7fff + ((x >> 16) & 1)) >> 16;
+        }
+
+        static float toFloat(uint16_t h)
+        {
+            uint32_t x = uint32_t(h) << 16;
+            float f;
+            memcpy(&f, &x, sizeof(f));
+            return f;
+        }
+    };
+
+    /// Rounding of convertSfs(): to nearest (ties to even), toward zero, toward -inf, toward +inf
+    enum class RoundMode
+    {
+        Near,
+        Zero,
+        Down,
+        Up
+    };
 }
 
 namespace
@@ -71,6 +167,86 @@ namespace
 
     template<typename _T> inline _T atan_cmath(_T x) { return atan(float(x)); }
     template<> inline double atan_cmath(double x) { return atan(x); }
+
+    //
+
+    /// Explicit ties to even for Near: does not depend on the FPU rounding mode
+    template<typename _T> inline _T round_cmath(_T x, simd::RoundMode mode)
+    {
+        switch (mode)
+        {
+            case simd::RoundMode::Zero: return std::trunc(x);
+            case simd::RoundMode::Down: return std::floor(x);
+            case simd::RoundMode::Up: return std::ceil(x);
+            case simd::RoundMode::Near: break;
+        }
+
+        _T r = std::floor(x);
+        _T diff = x - r;
+        if (diff > _T(0.5) || (diff == _T(0.5) && std::fmod(r, _T(2)) != 0))
+            r += 1;
+        return r;
+    }
+
+    //
+
+    /// x * 2^-sf rounded to nearest (ties to even) and saturated to _T, for |x| <= 2^62
+    template<typename _T> inline _T scale_sat(int64_t x, int sf)
+    {
+        const int64_t lo = std::numeric_limits<_T>::min();
+        const int64_t hi = std::numeric_limits<_T>::max();
+
+        if (sf > 62)
+            return 0;
+        if (sf > 0)
+        {
+            int64_t q = x >> sf;
+            int64_t r = x & ((int64_t(1) << sf) - 1);
+            int64_t half = int64_t(1) << (sf - 1);
+            if (r > half || (r == half && (q & 1)))
+                ++q;
+            x = q;
+        }
+        else if (sf < 0)
+        {
+            int64_t scale = int64_t(1) << ((sf < -62) ? 62 : -sf);
+            if (x > hi / scale)
+                return _T(hi);
+            if (x < lo / scale)
+                return _T(lo);
+            x *= scale;
+        }
+        return _T((x < lo) ? lo : (x > hi) ? hi : x);
+    }
+
+    /// The same for the unsigned 64-bit product of two uint32_t
+    template<typename _T> inline _T scale_sat(uint64_t x, int sf)
+    {
+        const uint64_t hi = std::numeric_limits<_T>::max();
+
+        if (sf > 63)
+            return (sf == 64 && x > (uint64_t(1) << 63)) ? 1 : 0;
+        if (sf > 0)
+        {
+            uint64_t q = x >> sf;
+            uint64_t r = x & ((uint64_t(1) << sf) - 1);
+            uint64_t half = uint64_t(1) << (sf - 1);
+            if (r > half || (r == half && (q & 1)))
+                ++q;
+            x = q;
+        }
+        else if (sf < 0)
+        {
+            int k = (sf < -63) ? 63 : -sf;
+            if (x > (hi >> k))
+                return _T(hi);
+            x <<= k;
+        }
+        return _T((x > hi) ? hi : x);
+    }
+
+    template<typename _T> inline int64_t mul_wide(_T a, _T b) { return int64_t(a) * b; }
+    inline uint64_t mul_wide(uint32_t a, uint32_t b) { return uint64_t(a) * b; }
 }
 
 namespace nosimd
@@ -114,6 +290,36 @@ namespace nosimd
             for (int i = 0; i < len; ++i)
                 pDst[i] = pSrc[i];
         }
+
+        /// pSrc * scale + offset, in float, then cast: results must fit _U as for convert
+        template<typename _T, typename _U>
+        inline void convertScale(const _T * pSrc, _U * pDst, int len, float scale, float offset)
+        {
+            for (int i = 0; i < len; ++i)
+                pDst[i] = (_U)(pSrc[i] * scale + offset);
+        }
+
+        /// pSrc * 2^-scaleFactor rounded by mode and saturated to _U, NaN gives 0
+        template<typename _T, typename _U>
+        inline void convertSfs(const _T * pSrc, _U * pDst, int len, simd::RoundMode mode, int scaleFactor)
+        {
+            const _T scale = std::ldexp(_T(1), -scaleFactor);
+            const _T lo = std::numeric_limits<_U>::min();
+            const _T hi = std::numeric_limits<_U>::max();
+
+            for (int i = 0; i < len; ++i)
+            {
+                _T r = round_cmath(pSrc[i] * scale, mode);
+                if (r != r)
+                    pDst[i] = 0;
+                else if (r <= lo)
+                    pDst[i] = std::numeric_limits<_U>::min();
+                else if (r >= hi)
+                    pDst[i] = std::numeric_limits<_U>::max();
+                else
+                    pDst[i] = (_U)r;
+            }
+        }
     }
 
     namespace compare
@@ -331,6 +537,51 @@ namespace nosimd
                 }
             }
         }
+
+        // Saturating 8, 16 and 32-bit integer arithmetic. The Sfs forms scale the exact result by 2^-scaleFactor,
+        // round it to nearest (ties to even) and saturate, as ipps*_Sfs. A negative scaleFactor scales up.
+
+        template<typename _T>
+        inline void addSfs(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+        {
+            static_assert(std::is_integral<_T>::value && sizeof(_T) <= 4, "8, 16 or 32-bit integers only");
+            for (int i = 0; i < len; ++i)
+                pDst[i] = scale_sat<_T>(int64_t(pSrc1[i]) + pSrc2[i], scaleFactor);
+        }
+
+        template<typename _T>
+        inline void subSfs(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+        {
+            static_assert(std::is_integral<_T>::value && sizeof(_T) <= 4, "8, 16 or 32-bit integers only");
+            for (int i = 0; i < len; ++i)
+                pDst[i] = scale_sat<_T>(int64_t(pSrc1[i]) - pSrc2[i], scaleFactor);
+        }
+
+        template<typename _T>
+        inline void mulSfs(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+        {
+            static_assert(std::is_integral<_T>::value && sizeof(_T) <= 4, "8, 16 or 32-bit integers only");
+            for (int i = 0; i < len; ++i)
+                pDst[i] = scale_sat<_T>(mul_wide(pSrc1[i], pSrc2[i]), scaleFactor);
+        }
+
+        template<typename _T>
+        inline void addSat(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+        {
+            addSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
+
+        template<typename _T>
+        inline void subSat(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+        {
+            subSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
+
+        template<typename _T>
+        inline void mulSat(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+        {
+            mulSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
     }
 
     namespace power
@@ -2,8 +2,19 @@
 #include "ocl_kernels.h"
 
 #include <vector>
+#include <map>
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <mutex>
+#include <cstdlib>
+#include <cstdio>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <cctype>
+#include <cmath>
+#include <chrono>
 
 #define CL_USE_DEPRECATED_OPENCL_1_2_APIS
 
@@ -13,6 +24,14 @@
 #include <CL/cl.h>
 #endif
 
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #define OCL_EXCEPTION(err) simd::Exception(__FILE__, __LINE__, __FUNCTION__, err)
 #define OCL_EXCEPT(err, msg) simd::Exception(__FILE__, __LINE__, __FUNCTION__, err, msg)
 
@@ -20,27 +39,152 @@ namespace ocl
 {
 namespace internals
 {
-    ///
-    template <typename _T>
-    class SrcDstBuffers
+    /// Reusable device buffers bucketed by size and cl_mem_flags.
+    /// Buffers are returned to the pool when the last shared_ptr owner goes away.
+    class BufferPool
     {
     public:
-        using DataType = _T;
         using ClMemType = std::remove_reference<decltype(*cl_mem())>::type; // _cl_mem
+        using BufferPtr = std::shared_ptr<ClMemType>;
 
-        SrcDstBuffers(cl_context gpuContext, uint32_t workSize)
-        :   workSize_(workSize)
+        static constexpr size_t minBucketSize() { return 4096; }
+        static constexpr size_t defaultMaxCached() { return size_t(256) << 20; }
+
+        BufferPool(cl_context gpuContext, size_t maxCached = defaultMaxCached())
+        :   gpuContext_(gpuContext),
+            state_(std::make_shared<State>(maxCached))
+        {}
+
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator = (const BufferPool&) = delete;
+
+        // round up with 4 buckets per power of two: no more than 25% waste
+        static size_t bucketSize(size_t dataSize)
+        {
+            if (dataSize <= minBucketSize())
+                return minBucketSize();
+
+            size_t pow2 = minBucketSize();
+            while (pow2 <= dataSize / 2)
+                pow2 <<= 1;
+            size_t step = pow2 / 4;
+            return (dataSize + step - 1) / step * step;
+        }
+
+        BufferPtr acquire(size_t dataSize, cl_mem_flags flags)
+        {
+            Key key(bucketSize(dataSize), flags);
+            cl_mem mem = state_->take(key);
+            if (!mem)
+                mem = create(key);
+
+            std::weak_ptr<State> weakState = state_;
+            return BufferPtr(mem, [weakState, key](cl_mem m)
+            {
+                if (auto st = weakState.lock())
+                    st->put(key, m);
+                else
+                    clReleaseMemObject(m);
+            });
+        }
+
+        void trim() { state_->clear(); }
+        size_t cachedBytes() const { return state_->cachedBytes(); }
+
+    private:
+        using Key = std::pair<size_t, cl_mem_flags>;
+
+        class State
+        {
+        public:
+            State(size_t maxCached)
+            :   maxCached_(maxCached)
+            {}
+
+            ~State() { clear(); }
+
+            cl_mem take(const Key& key)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = free_.find(key);
+                if (it == free_.end() || it->second.empty())
+                    return nullptr;
+
+                cl_mem mem = it->second.back();
+                it->second.pop_back();
+                cached_ -= key.first;
+                return mem;
+            }
+
+            void put(const Key& key, cl_mem mem)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (cached_ + key.first <= maxCached_)
+                    {
+                        free_[key].push_back(mem);
+                        cached_ += key.first;
+                        return;
+                    }
+                }
+                clReleaseMemObject(mem);
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& bucket : free_)
+                    for (cl_mem mem : bucket.second)
+                        clReleaseMemObject(mem);
+                free_.clear();
+                cached_ = 0;
+            }
+
+            size_t cachedBytes() const
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return cached_;
+            }
+
+        private:
+            mutable std::mutex mutex_;
+            std::map<Key, std::vector<cl_mem>> free_;
+            size_t cached_ = 0;
+            size_t maxCached_;
+        };
+
+        cl_context gpuContext_;
+        std::shared_ptr<State> state_;
+
+        cl_mem create(const Key& key)
         {
             cl_int err = 0;
-            srcA_ = std::shared_ptr<ClMemType>(
-                clCreateBuffer(gpuContext, CL_MEM_READ_ONLY, dataSize(), nullptr, &err), clReleaseMemObject);
+            cl_mem mem = clCreateBuffer(gpuContext_, key.second, key.first, nullptr, &err);
+            if (err == CL_MEM_OBJECT_ALLOCATION_FAILURE || err == CL_OUT_OF_RESOURCES)
+            {
+                // cached buffers may hold the memory we need: drop them and retry once
+                state_->clear();
+                mem = clCreateBuffer(gpuContext_, key.second, key.first, nullptr, &err);
+            }
             if (err)
                 throw OCL_EXCEPTION(err);
+            return mem;
+        }
+    };
 
-            dst_ = std::shared_ptr<ClMemType>(
-                clCreateBuffer(gpuContext, CL_MEM_WRITE_ONLY, dataSize(), nullptr, &err), clReleaseMemObject);
-            if (err)
-                throw OCL_EXCEPTION(err);
+    ///
+    template <typename _T>
+    class SrcDstBuffers
+    {
+    public:
+        using DataType = _T;
+        using ClMemType = BufferPool::ClMemType;
+
+        SrcDstBuffers(BufferPool& pool, uint32_t workSize)
+        :   workSize_(workSize)
+        {
+            srcA_ = pool.acquire(dataSize(), CL_MEM_READ_ONLY);
+            dst_ = pool.acquire(dataSize(), CL_MEM_WRITE_ONLY);
         }
 
         uint32_t workSize() const { return workSize_; }
@@ -51,8 +195,8 @@ namespace internals
 
     private:
         uint32_t workSize_;
-        std::shared_ptr<ClMemType> srcA_;
-        std::shared_ptr<ClMemType> dst_;
+        BufferPool::BufferPtr srcA_;
+        BufferPool::BufferPtr dst_;
     };
 
     ///
@@ -62,21 +206,16 @@ namespace internals
     public:
         using ClMemType = typename SrcDstBuffers<_T>::ClMemType;
 
-        SrcSrcDstBuffers(cl_context gpuContext, uint32_t workSize)
-        :   SrcDstBuffers<_T>(gpuContext, workSize)
+        SrcSrcDstBuffers(BufferPool& pool, uint32_t workSize)
+        :   SrcDstBuffers<_T>(pool, workSize)
         {
-            cl_int err = 0;
-            srcB_ = std::shared_ptr<ClMemType>(
-                clCreateBuffer(gpuContext, CL_MEM_READ_ONLY, SrcDstBuffers<_T>::dataSize(), nullptr, &err),
-                clReleaseMemObject);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            srcB_ = pool.acquire(SrcDstBuffers<_T>::dataSize(), CL_MEM_READ_ONLY);
         }
 
         cl_mem srcB() { return srcB_.get(); }
 
     private:
-        std::shared_ptr<ClMemType> srcB_;
+        BufferPool::BufferPtr srcB_;
     };
 
     ///
@@ -86,850 +225,3609 @@ namespace internals
     public:
         using ClMemType = typename SrcDstBuffers<_T>::ClMemType;
 
-        SrcValDstBuffers(cl_context gpuContext, uint32_t workSize)
-        :   SrcDstBuffers<_T>(gpuContext, workSize)
+        SrcValDstBuffers(BufferPool& pool, uint32_t workSize)
+        :   SrcDstBuffers<_T>(pool, workSize)
         {}
     };
 
-    template <typename _T>
-    struct BufferType;
-
-    template <typename _T>
-    struct BufferType<Kernel::PtrPtrPtr<_T>>
+    ///
+    class DeviceBuffer
     {
-        using Type = SrcSrcDstBuffers<_T>;
-    };
+    public:
+        DeviceBuffer(std::shared_ptr<SimdOpenCl> owner, BufferPool::BufferPtr mem, size_t dataSize)
+        :   owner_(owner), mem_(mem), dataSize_(dataSize)
+        {}
 
-    template <typename _T>
-    struct BufferType<Kernel::PtrValPtr<_T>>
-    {
-        using Type = SrcValDstBuffers<_T>;
+        SimdOpenCl& owner() const { return *owner_; }
+        cl_mem mem() const { return mem_.get(); }
+        size_t dataSize() const { return dataSize_; }
+
+    private:
+        std::shared_ptr<SimdOpenCl> owner_;
+        BufferPool::BufferPtr mem_;
+        size_t dataSize_;
     };
 
-    ///
-    class SimdOpenCl
+    /// Keeps the completion event and everything the operation still uses (pooled buffers) alive
+    class EventState
     {
     public:
-        static SimdOpenCl& getInstance()
-        {
-            static const uint32_t platformId = 0;
-            static const uint32_t deviceId = 0;
-            static SimdOpenCl instance(platformId, CL_DEVICE_TYPE_GPU, deviceId);
-            return instance;
-        }
+        using ClEventType = std::remove_reference<decltype(*cl_event())>::type; // _cl_event
 
-        static size_t alignedSize(size_t requiredSize)
+        EventState(cl_event event, std::shared_ptr<void> resources)
+        :   event_(event, clReleaseEvent),
+            resources_(resources)
+        {}
+
+        /// Completes with all parts: a call split over several devices. Has no cl_event of its own.
+        explicit EventState(const EventList& parts)
+        :   parts_(parts)
+        {}
+
+        cl_event event() const { return event_.get(); }
+
+        void wait()
         {
-            if (requiredSize == 0)
-                return localWorkSize();
-#if 1
-            return requiredSize + (~requiredSize + 1) % localWorkSize();
-#else
-            size_t r = requiredSize % localWorkSize();
-            return requiredSize + (r ? (localWorkSize() - r) : 0);
-#endif
+            if (!event_)
+            {
+                for (const Event& part : parts_)
+                    part.wait();
+                return;
+            }
+
+            cl_event ev = event();
+            cl_int err = clWaitForEvents(1, &ev);
+            if (err)
+                throw OCL_EXCEPTION(err);
+            resources_.reset();
         }
 
-        template <typename _T>
-        void exec(typename _T::DataTypeSrc1 src1, typename _T::DataTypeSrc2 src2,
-                typename _T::DataTypeDst dst, int size)
+        bool ready() const
         {
-            uint32_t workSize = alignedSize(size);
-            typename BufferType<typename _T::BaseType>::Type buffers(gpuContext(), workSize);
-            //size_t dataSize = buffers.dataSize();
-
-            cl_kernel kernel = programs_[static_cast<uint32_t>(_T::id())].kernel();
-            setArgs(kernel, buffers, size);
+            if (!event_)
+            {
+                for (const Event& part : parts_)
+                    if (!part.ready())
+                        return false;
+                return true;
+            }
 
-            runCoreSequence(src1, src2, dst, kernel, buffers);
+            cl_int status = CL_QUEUED;
+            cl_int err = clGetEventInfo(event(), CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+            if (status < 0)
+                throw OCL_EXCEPTION(status);
+            return status == CL_COMPLETE;
         }
 
     private:
-        using ContextType = std::remove_reference<decltype(*cl_context())>::type;           // _cl_context
-        using CmdQueueType = std::remove_reference<decltype(*cl_command_queue())>::type;    // _cl_command_queue
-        using ProgramType = std::remove_reference<decltype(*cl_program())>::type;           // _cl_program
-        using KernelType = std::remove_reference<decltype(*cl_kernel())>::type;             // _cl_kernel
+        std::shared_ptr<ClEventType> event_;
+        std::shared_ptr<void> resources_;
+        EventList parts_;
+    };
 
-        ///
-        class BuiltProgram
+    /// Split calls span several contexts and have no cl_event: the host waits for them instead
+    static std::vector<cl_event> clEvents(const EventList& events)
+    {
+        std::vector<cl_event> out;
+        out.reserve(events.size());
+        for (auto& ev : events)
         {
-        public:
-            void setProgram(cl_program prog) { program_ = std::shared_ptr<ProgramType>(prog, clReleaseProgram); }
-            void setKernel(cl_kernel kern) { kernel_ = std::shared_ptr<KernelType>(kern, clReleaseKernel); }
+            if (!ev.state())
+                continue;
+            if (ev.state()->event())
+                out.push_back(ev.state()->event());
+            else
+                ev.wait();
+        }
+        return out;
+    }
 
-            cl_program program() { return program_.get(); }
-            cl_kernel kernel() { return kernel_.get(); }
+    static PipelineOptions& pipelineOpts()
+    {
+        static PipelineOptions opts;
+        return opts;
+    }
 
-        private:
-            std::shared_ptr<ProgramType> program_;
-            std::shared_ptr<KernelType> kernel_;
-        };
+    /// CL_MEM_USE_HOST_PTR buffers wrapping the caller's arrays. dst is mapped when the operation
+    /// completes; releasing the buffers unmaps it and waits, so the caller reads coherent host memory.
+    class HostPtrBuffers
+    {
+    public:
+        using BufferPtr = BufferPool::BufferPtr;
 
-        cl_platform_id platform_ = nullptr;
-        cl_device_id device_ = nullptr;
-        std::shared_ptr<ContextType> gpuContext_;
-        std::shared_ptr<CmdQueueType> commandQueue_;
-        std::vector<BuiltProgram> programs_; // implicit hash_map<(uint32_t)Kernel::Func, BuiltProgram>
+        HostPtrBuffers(cl_context gpuContext, cl_command_queue queue)
+        :   gpuContext_(gpuContext), queue_(queue)
+        {}
 
-        static constexpr uint32_t localWorkSize() { return 256; }
-        cl_context gpuContext() { return gpuContext_.get(); }
-        cl_command_queue commandQueue() { return commandQueue_.get(); }
+        HostPtrBuffers(const HostPtrBuffers&) = delete;
+        HostPtrBuffers& operator = (const HostPtrBuffers&) = delete;
 
-        SimdOpenCl(uint32_t platformId, cl_device_type deviceType, uint32_t deviceId)
+        ~HostPtrBuffers()
         {
-            cl_uint numPlatforms;
-            cl_int err = 0;
-            err = clGetPlatformIDs(0, nullptr, &numPlatforms);
-            if (err || numPlatforms <= platformId)
-                throw OCL_EXCEPTION(err);
+            if (!mapped_)
+                return;
 
-            std::vector<cl_platform_id> platforms(numPlatforms);
-            err = clGetPlatformIDs(numPlatforms, platforms.data(), nullptr);
-            if (err)
-                throw OCL_EXCEPTION(err);
-            platform_ = platforms[platformId];
+            cl_event unmapped = nullptr;
+            if (clEnqueueUnmapMemObject(queue_, dst_.get(), mapped_, 0, nullptr, &unmapped) == CL_SUCCESS)
+            {
+                clWaitForEvents(1, &unmapped);
+                clReleaseEvent(unmapped);
+            }
+        }
 
-            cl_uint numDevices;
-            err = clGetDeviceIDs(platform_, deviceType, 0, nullptr, &numDevices);
-            if (err || numDevices <= deviceId)
-                throw OCL_EXCEPTION(err);
-            std::vector<cl_device_id> devices(numDevices);
-            err = clGetDeviceIDs(platform_, deviceType, numDevices, devices.data(), nullptr);
-            if (err)
-                throw OCL_EXCEPTION(err);
-            device_ = devices[deviceId];
+        void wrapSrcA(const void * ptr, size_t dataSize) { srcA_ = wrap(ptr, dataSize, CL_MEM_READ_ONLY); }
+        void wrapSrcB(const void * ptr, size_t dataSize) { srcB_ = wrap(ptr, dataSize, CL_MEM_READ_ONLY); }
+        void wrapDst(void * ptr, size_t dataSize) { dst_ = wrap(ptr, dataSize, CL_MEM_WRITE_ONLY); }
 
-            gpuContext_ = std::shared_ptr<ContextType>(
-                clCreateContext(nullptr, 1, &device_, nullptr, nullptr, &err), clReleaseContext);
+        cl_mem srcA() { return srcA_.get(); }
+        cl_mem srcB() { return srcB_.get(); }
+        cl_mem dst() { return dst_.get(); }
+
+        cl_event mapDst(size_t dataSize)
+        {
+            cl_event done = nullptr;
+            cl_int err = 0;
+            mapped_ = clEnqueueMapBuffer(queue_, dst(), CL_FALSE, CL_MAP_READ, 0, dataSize, 0, nullptr, &done, &err);
             if (err)
                 throw OCL_EXCEPTION(err);
+            return done;
+        }
 
-#ifdef CL_USE_DEPRECATED_OPENCL_1_2_APIS
-            commandQueue_ = std::shared_ptr<CmdQueueType>(
-                clCreateCommandQueue(gpuContext(), device_, 0, &err), clReleaseCommandQueue);
-#else
-            commandQueue_ = std::shared_ptr<CmdQueueType>(
-                clCreateCommandQueueWithProperties(gpuContext(), device_, nullptr, &err), clReleaseCommandQueue);
-#endif
+    private:
+        cl_context gpuContext_;
+        cl_command_queue queue_;
+        BufferPtr srcA_;
+        BufferPtr srcB_;
+        BufferPtr dst_;
+        void * mapped_ = nullptr;
+
+        BufferPtr wrap(const void * ptr, size_t dataSize, cl_mem_flags flags)
+        {
+            cl_int err = 0;
+            cl_mem mem = clCreateBuffer(gpuContext_, flags | CL_MEM_USE_HOST_PTR, dataSize, const_cast<void *>(ptr), &err);
             if (err)
                 throw OCL_EXCEPTION(err);
-
-            makePrograms();
+            return BufferPtr(mem, clReleaseMemObject);
         }
+    };
+
+    static std::string deviceInfo(cl_device_id device, cl_device_info param)
+    {
+        size_t size = 0;
+        if (clGetDeviceInfo(device, param, 0, nullptr, &size) || !size)
+            return std::string();
+        std::vector<char> buf(size);
+        if (clGetDeviceInfo(device, param, size, buf.data(), nullptr))
+            return std::string();
+        return std::string(buf.data());
+    }
+
+    static std::string platformInfo(cl_platform_id platform, cl_platform_info param)
+    {
+        size_t size = 0;
+        if (clGetPlatformInfo(platform, param, 0, nullptr, &size) || !size)
+            return std::string();
+        std::vector<char> buf(size);
+        if (clGetPlatformInfo(platform, param, size, buf.data(), nullptr))
+            return std::string();
+        return std::string(buf.data());
+    }
+
+    /// Walks all platforms and devices and picks the best match for a DeviceSelector
+    class DeviceFinder
+    {
+    public:
+        struct Found
+        {
+            cl_platform_id platform = nullptr;
+            cl_device_id device = nullptr;
+        };
 
-        void makePrograms()
+        static Found find(const DeviceSelector& sel)
         {
-            programs_.resize(Kernel::funcCount());
-            for (uint32_t i = 0; i < Kernel::funcCount(); ++i) {
-                makeKernel((Kernel::Func)i, programs_[i]);
+            Found best;
+            int bestRank = 0;
+            for (const Ranked& r : matching(sel))
+            {
+                if (r.rank > bestRank) // first device of the best rank wins
+                {
+                    bestRank = r.rank;
+                    best = r.found;
+                }
             }
+            return best;
         }
 
-        void makeKernel(Kernel::Func func, BuiltProgram& prog)
+        /// Every matching device in platform and device order
+        static std::vector<Found> findAll(const DeviceSelector& sel)
         {
-            cl_int err = 0;
-            Kernel::TextProgram srcProg = Kernel::program(func);
-            size_t progLength = strlen(srcProg.text);
+            std::vector<Found> all;
+            for (const Ranked& r : matching(sel))
+                all.push_back(r.found);
+            return all;
+        }
 
-            if (programs_.size() <= static_cast<uint32_t>(func))
-                throw OCL_EXCEPTION(0);
+    private:
+        struct Ranked
+        {
+            Found found;
+            int rank;
+        };
+
+        static std::vector<Ranked> matching(const DeviceSelector& sel)
+        {
+            cl_uint numPlatforms = 0;
+            cl_int err = clGetPlatformIDs(0, nullptr, &numPlatforms);
+            if (err || !numPlatforms)
+                throw OCL_EXCEPTION(err);
 
-            prog.setProgram(clCreateProgramWithSource(gpuContext(), 1, (const char **)&srcProg.text, &progLength, &err));
+            std::vector<cl_platform_id> platforms(numPlatforms);
+            err = clGetPlatformIDs(numPlatforms, platforms.data(), nullptr);
             if (err)
                 throw OCL_EXCEPTION(err);
 
-            //const char* flags = "-cl-fast-relaxed-math";
-            err = clBuildProgram(prog.program(), 1, &device_, nullptr, nullptr, nullptr);
-            if (err == CL_BUILD_PROGRAM_FAILURE)
+            std::vector<Ranked> res;
+            for (cl_uint p = 0; p < numPlatforms; ++p)
             {
-                size_t size;
-                err = clGetProgramBuildInfo(prog.program(), device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size);
-                if (err)
-                    OCL_EXCEPTION(err);
-                std::vector<char> info(size);
-                clGetProgramBuildInfo(prog.program(), device_, CL_PROGRAM_BUILD_LOG, size, info.data(), nullptr);
-                if (err)
-                    OCL_EXCEPTION(err);
-                OCL_EXCEPT(CL_BUILD_PROGRAM_FAILURE, info.data());
+                if (sel.platformIndex >= 0 && static_cast<cl_uint>(sel.platformIndex) != p)
+                    continue;
+
+                cl_uint numDevices = 0;
+                if (clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices) || !numDevices)
+                    continue;
+                std::vector<cl_device_id> devices(numDevices);
+                if (clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr))
+                    continue;
+
+                for (cl_uint d = 0; d < numDevices; ++d)
+                {
+                    if (sel.deviceIndex >= 0 && static_cast<cl_uint>(sel.deviceIndex) != d)
+                        continue;
+                    if (!sel.vendor.empty() && !matchesVendor(platforms[p], devices[d], sel.vendor))
+                        continue;
+
+                    int r = rank(devices[d], sel.type);
+                    if (r)
+                        res.push_back({{platforms[p], devices[d]}, r});
+                }
             }
-            if (err)
-                throw OCL_EXCEPTION(err);
 
-            prog.setKernel(clCreateKernel(prog.program(), srcProg.name, &err));
-            if (err)
-                throw OCL_EXCEPTION(err);
+            if (res.empty())
+                throw OCL_EXCEPT(CL_DEVICE_NOT_FOUND, "no OpenCL device matches the selector");
+            return res;
         }
 
-        template <typename _T>
-        void setArgs(cl_kernel& kernel, SrcSrcDstBuffers<_T>& bufs, uint32_t count)
+        // 0: excluded
+        static int rank(cl_device_id device, DeviceSelector::Type type)
         {
-            cl_mem srcA = bufs.srcA();
-            cl_mem srcB = bufs.srcB();
-            cl_mem dst = bufs.dst();
+            cl_device_type devType = 0;
+            if (clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(devType), &devType, nullptr))
+                return 0;
 
-            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &srcA);
-            err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &srcB);
-            err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &dst);
-            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &count);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            switch (type)
+            {
+                case DeviceSelector::Type::Gpu: return (devType & CL_DEVICE_TYPE_GPU) ? 1 : 0;
+                case DeviceSelector::Type::Accelerator: return (devType & CL_DEVICE_TYPE_ACCELERATOR) ? 1 : 0;
+                case DeviceSelector::Type::Cpu: return (devType & CL_DEVICE_TYPE_CPU) ? 1 : 0;
+                case DeviceSelector::Type::Any:
+                    break;
+            }
+
+            if (devType & CL_DEVICE_TYPE_GPU)
+                return 4;
+            if (devType & CL_DEVICE_TYPE_ACCELERATOR)
+                return 3;
+            if (devType & CL_DEVICE_TYPE_CPU)
+                return 2;
+            return 1;
         }
 
-        template <typename _T>
-        void setArgs(cl_kernel& kernel, SrcValDstBuffers<_T>& bufs, uint32_t count)
+        static bool matchesVendor(cl_platform_id platform, cl_device_id device, const std::string& vendor)
         {
-            cl_mem srcA = bufs.srcA();
-            cl_mem dst = bufs.dst();
-
-            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &srcA);
-            //err |= clSetKernelArg(kernel, 1, sizeof(_T), &bufs.srcB);
-            err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &dst);
-            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &count);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            std::string needle = lower(vendor);
+            for (const std::string& s : { platformInfo(platform, CL_PLATFORM_NAME),
+                                          platformInfo(platform, CL_PLATFORM_VENDOR),
+                                          deviceInfo(device, CL_DEVICE_NAME),
+                                          deviceInfo(device, CL_DEVICE_VENDOR) })
+            {
+                if (lower(s).find(needle) != std::string::npos)
+                    return true;
+            }
+            return false;
         }
 
-        template <typename _T>
-        void runCoreSequence(const _T * src1, const _T * src2, _T * dst, cl_kernel kernel, SrcSrcDstBuffers<_T>& bufs)
+        static std::string lower(std::string s)
         {
-            asyncWriteToGPU(src1, bufs.dataSize(), bufs.srcA());
-            asyncWriteToGPU(src2, bufs.dataSize(), bufs.srcB());
-            launchKernel(kernel, bufs.workSize());
-            syncReadFromGPU(dst, bufs.dataSize(), bufs.dst());
+            for (char& c : s)
+                c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            return s;
         }
+    };
 
-        template <typename _T>
-        void runCoreSequence(const _T * src1, _T src2, _T * dst, cl_kernel kernel, SrcValDstBuffers<_T>& bufs)
+    /// Compiled program binaries on disk, one file per (device, driver, build options, source) hash.
+    /// The directory is $SIMD_OCL_CACHE_DIR, else $XDG_CACHE_HOME/libsimd-ocl, else $HOME/.cache/libsimd-ocl.
+    /// SIMD_OCL_CACHE_DIR set to an empty string disables the cache.
+    class ProgramCache
+    {
+    public:
+        void setDevice(cl_platform_id platform, cl_device_id device)
         {
-            cl_int err = clSetKernelArg(kernel, 1, sizeof(_T), &src2);
-            if (err)
-                throw OCL_EXCEPTION(err);
-
-            asyncWriteToGPU(src1, bufs.dataSize(), bufs.srcA());
-            launchKernel(kernel, bufs.workSize());
-            syncReadFromGPU(dst, bufs.dataSize(), bufs.dst());
+            dir_ = cacheDir();
+            if (!dir_.empty())
+                makeDirs(dir_); // failures surface as misses: store() then quietly does nothing
+
+            deviceKey_ = platformInfo(platform, CL_PLATFORM_VERSION);
+            deviceKey_ += '\n' + deviceInfo(device, CL_DEVICE_NAME);
+            deviceKey_ += '\n' + deviceInfo(device, CL_DEVICE_VERSION);
+            deviceKey_ += '\n' + deviceInfo(device, CL_DRIVER_VERSION);
         }
 
-        void launchKernel(cl_kernel kernel, size_t workSize)
+        /// Empty when caching is disabled
+        std::string path(const char * source, const char * options) const
         {
-            size_t localWS = localWorkSize();
-            cl_int err = clEnqueueNDRangeKernel(
-                commandQueue(), kernel, 1, nullptr, &workSize, &localWS, 0, nullptr, nullptr);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            if (dir_.empty())
+                return std::string();
+
+            uint64_t h = hash(deviceKey_.data(), deviceKey_.size(), fnvOffset());
+            h = hash(options, strlen(options) + 1, h);
+            h = hash(source, strlen(source), h);
+
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)h);
+            return dir_ + '/' + name;
         }
 
-        void asyncWriteToGPU(const void * src, size_t dataSize, cl_mem gpuBuffer)
+        static bool load(const std::string& path, std::vector<unsigned char>& binary)
         {
-            cl_int err = clEnqueueWriteBuffer(
-                commandQueue(), gpuBuffer, CL_FALSE, 0, dataSize, src, 0, nullptr, nullptr);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            std::ifstream in(path, std::ios::binary);
+            if (!in)
+                return false;
+            binary.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+            return !binary.empty();
         }
 
-        void syncReadFromGPU(void * dst, size_t dataSize, cl_mem gpuBuffer)
+        /// Written under a temporary name and renamed: concurrent processes never see a partial file
+        static void store(const std::string& path, const std::vector<unsigned char>& binary)
         {
-            cl_int err = clEnqueueReadBuffer(
-                commandQueue(), gpuBuffer, CL_TRUE, 0, dataSize, dst, 0, nullptr, nullptr);
-            if (err)
-                throw OCL_EXCEPTION(err);
+            std::string tmp = path + '.' + std::to_string(processId());
+            {
+                std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+                if (!out)
+                    return;
+                out.write(reinterpret_cast<const char *>(binary.data()), binary.size());
+                if (!out)
+                {
+                    out.close();
+                    std::remove(tmp.c_str());
+                    return;
+                }
+            }
+#ifdef _WIN32
+            std::remove(path.c_str());
+#endif
+            if (std::rename(tmp.c_str(), path.c_str()))
+                std::remove(tmp.c_str());
         }
-    };
 
-    int alignedSize(int len)
-    {
+    private:
+        std::string dir_;
+        std::string deviceKey_;
+
+        static constexpr uint64_t fnvOffset() { return 14695981039346656037ull; }
+
+        // FNV-1a
+        static uint64_t hash(const void * data, size_t size, uint64_t h)
+        {
+            const unsigned char * p = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                h ^= p[i];
+                h *= 1099511628211ull;
+            }
+            return h;
+        }
+
+        static std::string cacheDir()
+        {
+            if (const char * dir = getenv("SIMD_OCL_CACHE_DIR"))
+                return dir;
+            if (const char * xdg = getenv("XDG_CACHE_HOME"))
+                if (*xdg)
+                    return std::string(xdg) + "/libsimd-ocl";
+#ifdef _WIN32
+            const char * home = getenv("LOCALAPPDATA");
+#else
+            const char * home = getenv("HOME");
+#endif
+            if (home && *home)
+                return std::string(home) + "/.cache/libsimd-ocl";
+            return std::string();
+        }
+
+        static void makeDirs(const std::string& dir)
+        {
+            for (size_t pos = 1; pos <= dir.size(); ++pos)
+            {
+                if (pos != dir.size() && dir[pos] != '/')
+                    continue;
+                std::string part = dir.substr(0, pos);
+#ifdef _WIN32
+                _mkdir(part.c_str());
+#else
+                mkdir(part.c_str(), 0755);
+#endif
+            }
+        }
+
+        static int processId()
+        {
+#ifdef _WIN32
+            return _getpid();
+#else
+            return getpid();
+#endif
+        }
+    };
+
+    template <typename _T>
+    struct BufferType;
+
+    template <typename _T>
+    struct BufferType<Kernel::PtrPtrPtr<_T>>
+    {
+        using Type = SrcSrcDstBuffers<_T>;
+    };
+
+    template <typename _T>
+    struct BufferType<Kernel::PtrValPtr<_T>>
+    {
+        using Type = SrcValDstBuffers<_T>;
+    };
+
+    ///
+    class SimdOpenCl : public std::enable_shared_from_this<SimdOpenCl>
+    {
+    public:
+        static std::shared_ptr<SimdOpenCl> create(const DeviceSelector& selector)
+        {
+            return create(DeviceFinder::find(selector));
+        }
+
+        static std::shared_ptr<SimdOpenCl> create(const DeviceFinder::Found& found)
+        {
+            return std::shared_ptr<SimdOpenCl>(new SimdOpenCl(found.platform, found.device));
+        }
+
+        static std::shared_ptr<SimdOpenCl> defaultInstance()
+        {
+            static std::shared_ptr<SimdOpenCl> instance = create(DeviceSelector::fromEnvironment());
+            return instance;
+        }
+
+        /// Set by ContextScope
+        static SimdOpenCl *& current()
+        {
+            static thread_local SimdOpenCl * cur = nullptr;
+            return cur;
+        }
+
+        /// The calling thread's context: the innermost ContextScope, else the default one
+        static SimdOpenCl& getInstance()
+        {
+            if (SimdOpenCl * cur = current())
+                return *cur;
+            return *defaultInstance();
+        }
+
+        std::string deviceName() const { return deviceInfo(device_, CL_DEVICE_NAME); }
+
+        static size_t alignedSize(size_t requiredSize)
+        {
+            if (requiredSize == 0)
+                return sizeAlignment();
+#if 1
+            return requiredSize + (~requiredSize + 1) % sizeAlignment();
+#else
+            size_t r = requiredSize % sizeAlignment();
+            return requiredSize + (r ? (sizeAlignment() - r) : 0);
+#endif
+        }
+
+        template <typename _T>
+        Event exec(typename _T::DataTypeSrc1 src1, typename _T::DataTypeSrc2 src2,
+                typename _T::DataTypeDst dst, int size, const EventList& waitFor)
+        {
+            using Buffers = typename BufferType<typename _T::BaseType>::Type;
+
+            if (hostUnifiedMemory_ && !aliases(src1, dst) && !aliases(src2, dst) &&
+                hostAligned(src1) && hostAligned(src2) && hostAligned(dst))
+                return execZeroCopy<_T>(src1, src2, dst, size, waitFor);
+
+            const PipelineOptions& opts = pipelineOpts();
+            if (opts.queues > 1 && size >= opts.minLength && size > opts.chunkLength)
+                return execPipelined<_T>(src1, src2, dst, size, waitFor);
+
+            uint32_t workSize = alignedSize(size);
+            auto buffers = std::make_shared<Buffers>(*bufferPool_, workSize);
+
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            setArgs(kernel, *buffers, size);
+
+            std::vector<cl_event> waitList = clEvents(waitFor);
+            cl_event done = runCoreSequence(src1, src2, dst, prog, *buffers, size, waitList);
+            return Event(std::make_shared<EventState>(done, buffers));
+        }
+
+        /// The device shares memory with the host: wrap the caller's arrays instead of copying them.
+        /// In-place calls take the copying path, as two buffers over the same host memory are undefined.
+        template <typename _T>
+        Event execZeroCopy(typename _T::DataTypeSrc1 src1, typename _T::DataTypeSrc2 src2,
+                typename _T::DataTypeDst dst, int size, const EventList& waitFor)
+        {
+            using ItemType = typename _T::ItemType;
+            size_t dataSize = size * sizeof(ItemType);
+
+            auto buffers = std::make_shared<HostPtrBuffers>(gpuContext(), commandQueue());
+            buffers->wrapSrcA(src1, dataSize);
+            wrapSrcB(*buffers, src2, dataSize);
+            buffers->wrapDst(dst, dataSize);
+
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            setArgs(kernel, buffers->srcA(), buffers->srcB(), buffers->dst(), size);
+            setScalarArg(kernel, src2);
+
+            launchKernel(commandQueue(), prog, size, clEvents(waitFor));
+
+            cl_event done = buffers->mapDst(dataSize);
+            return Event(std::make_shared<EventState>(done, buffers));
+        }
+
+        template <typename _T>
+        static bool aliases(const _T * src, const _T * dst) { return src == dst; }
+
+        template <typename _T>
+        static bool aliases(_T, const _T *) { return false; }
+
+        /// Misaligned host memory can't back a CL_MEM_USE_HOST_PTR buffer without a hidden copy
+        template <typename _T>
+        bool hostAligned(_T * ptr) const { return reinterpret_cast<uintptr_t>(ptr) % baseAddrAlign_ == 0; }
+
+        template <typename _T>
+        static bool hostAligned(_T) { return true; }
+
+        template <typename _T>
+        static void wrapSrcB(HostPtrBuffers& bufs, const _T * src, size_t dataSize) { bufs.wrapSrcB(src, dataSize); }
+
+        template <typename _T>
+        static void wrapSrcB(HostPtrBuffers&, _T, size_t) {}
+
+        /// Chunk i goes to queue i % queues. Each queue owns one buffer set, reused by its next chunk
+        /// once the in-order queue has finished with it; different queues overlap transfers and compute.
+        template <typename _T>
+        Event execPipelined(typename _T::DataTypeSrc1 src1, typename _T::DataTypeSrc2 src2,
+                typename _T::DataTypeDst dst, int size, const EventList& waitFor)
+        {
+            using Buffers = typename BufferType<typename _T::BaseType>::Type;
+            using ItemType = typename _T::ItemType;
+
+            const PipelineOptions& opts = pipelineOpts();
+            uint32_t chunkWork = alignedSize(opts.chunkLength);
+            int chunkLen = chunkWork;
+            int numChunks = (size + chunkLen - 1) / chunkLen;
+            int numQueues = std::min(opts.queues, numChunks);
+
+            auto buffers = std::make_shared<std::vector<std::shared_ptr<Buffers>>>();
+            for (int q = 0; q < numQueues; ++q)
+                buffers->push_back(std::make_shared<Buffers>(*bufferPool_, chunkWork));
+
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            setScalarArg(kernel, src2);
+
+            std::vector<cl_event> waitList = clEvents(waitFor);
+            std::vector<cl_event> lastReads(numQueues, nullptr);
+            try
+            {
+                for (int chunk = 0; chunk < numChunks; ++chunk)
+                {
+                    int q = chunk % numQueues;
+                    int offset = chunk * chunkLen;
+                    int count = std::min(chunkLen, size - offset);
+                    Buffers& bufs = *(*buffers)[q];
+
+                    // kernel arguments are captured at enqueue time, so one kernel object serves all queues
+                    setArgs(kernel, bufs, count);
+                    cl_command_queue queue = pipelineQueue(q);
+                    const std::vector<cl_event>& firstWait = (chunk < numQueues) ? waitList : noEvents();
+
+                    writeChunk(queue, src1, src2, offset, count, bufs, firstWait);
+                    launchKernel(queue, prog, count);
+
+                    if (lastReads[q])
+                        clReleaseEvent(lastReads[q]);
+                    lastReads[q] = nullptr; // keep the catch below from releasing it twice
+                    lastReads[q] = asyncReadFromGPU(queue, dst + offset, count * sizeof(ItemType), bufs.dst());
+                }
+
+                for (int q = 0; q < numQueues; ++q)
+                    flush(pipelineQueue(q));
+            }
+            catch (...)
+            {
+                releaseEvents(lastReads);
+                throw;
+            }
+
+            cl_event done = nullptr;
+            cl_int err = clEnqueueMarkerWithWaitList(commandQueue(), lastReads.size(), lastReads.data(), &done);
+            releaseEvents(lastReads);
+            if (err)
+                throw OCL_EXCEPTION(err);
+            return Event(std::make_shared<EventState>(done, buffers));
+        }
+
+        /// Device-resident variant: arguments are already on the GPU, nothing is transferred
+        template <typename _T>
+        void execOnDevice(cl_mem src1, cl_mem src2, cl_mem dst, int size)
+        {
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            setArgs(kernel, src1, src2, dst, size);
+            launchKernel(commandQueue(), prog, size);
+        }
+
+        template <typename _T>
+        void execOnDevice(cl_mem src1, typename _T::ItemType src2, cl_mem dst, int size)
+        {
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            setArgs(kernel, src1, nullptr, dst, size);
+
+            cl_int err = clSetKernelArg(kernel, 1, sizeof(src2), &src2);
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            launchKernel(commandQueue(), prog, size);
+        }
+
+        /// Generated kernel fused(inputs..., scalars..., out, size), one element per work item
+        template <typename _T>
+        void execFused(const std::string& text, const std::vector<cl_mem>& inputs, const std::vector<_T>& scalars,
+                       cl_mem dst, int size)
+        {
+            BuiltProgram& prog = getFused(text);
+            cl_kernel kernel = prog.kernel();
+
+            cl_uint arg = 0;
+            cl_int err = 0;
+            for (cl_mem mem : inputs)
+                err |= clSetKernelArg(kernel, arg++, sizeof(cl_mem), &mem);
+            for (const _T& val : scalars)
+                err |= clSetKernelArg(kernel, arg++, sizeof(_T), &val);
+            err |= clSetKernelArg(kernel, arg++, sizeof(cl_mem), &dst);
+            err |= clSetKernelArg(kernel, arg++, sizeof(cl_int), &size);
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            launchKernel(commandQueue(), prog, size);
+        }
+
+        /// Generated kernels cached so far, one per source text
+        size_t fusedCount()
+        {
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            return fused_.size();
+        }
+
+        /// Two passes: every group folds a grid-stride slice into a partial, then one group folds the partials
+        template <typename _T>
+        typename _T::ItemType reduce(cl_mem src1, cl_mem src2, typename _T::ItemType c, int size)
+        {
+            using ItemType = typename _T::ItemType;
+
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            size_t localWS = reduceLocalSize(prog);
+            size_t groups = reduceGroups(size, localWS);
+
+            BufferPool::BufferPtr partial = bufferPool_->acquire(groups * sizeof(ItemType), CL_MEM_READ_WRITE);
+            BufferPool::BufferPtr result = bufferPool_->acquire(sizeof(ItemType), CL_MEM_READ_WRITE);
+
+            setReduceArgs(kernel, src1, src2, c, size, 0, partial.get(), localWS * sizeof(ItemType));
+            enqueueRange(kernel, groups * localWS, localWS);
+
+            setReduceArgs(kernel, partial.get(), nullptr, c, groups, 1, result.get(), localWS * sizeof(ItemType));
+            enqueueRange(kernel, localWS, localWS);
+
+            ItemType out;
+            syncReadFromGPU(&out, sizeof(out), result.get());
+            return out;
+        }
+
+        template <typename _T>
+        typename _T::ItemType reduceIndx(cl_mem src, int size, int * pIndx)
+        {
+            using ItemType = typename _T::ItemType;
+
+            BuiltProgram& prog = getProgram(_T::id());
+            cl_kernel kernel = prog.kernel();
+            size_t localWS = reduceLocalSize(prog);
+            size_t groups = reduceGroups(size, localWS);
+
+            BufferPool::BufferPtr partialVal = bufferPool_->acquire(groups * sizeof(ItemType), CL_MEM_READ_WRITE);
+            BufferPool::BufferPtr partialIdx = bufferPool_->acquire(groups * sizeof(cl_int), CL_MEM_READ_WRITE);
+            BufferPool::BufferPtr resultVal = bufferPool_->acquire(sizeof(ItemType), CL_MEM_READ_WRITE);
+            BufferPool::BufferPtr resultIdx = bufferPool_->acquire(sizeof(cl_int), CL_MEM_READ_WRITE);
+
+            setReduceIndxArgs<ItemType>(kernel, src, nullptr, size, partialVal.get(), partialIdx.get(), localWS);
+            enqueueRange(kernel, groups * localWS, localWS);
+
+            setReduceIndxArgs<ItemType>(kernel, partialVal.get(), partialIdx.get(), groups,
+                                        resultVal.get(), resultIdx.get(), localWS);
+            enqueueRange(kernel, localWS, localWS);
+
+            ItemType out;
+            cl_int idx = 0;
+            syncReadFromGPU(&out, sizeof(out), resultVal.get());
+            syncReadFromGPU(&idx, sizeof(idx), resultIdx.get());
+            *pIndx = idx;
+            return out;
+        }
+
+        std::shared_ptr<DeviceBuffer> allocDevice(size_t dataSize)
+        {
+            return std::make_shared<DeviceBuffer>(shared_from_this(), bufferPool_->acquire(dataSize, CL_MEM_READ_WRITE), dataSize);
+        }
+
+        void syncWriteToGPU(const void * src, size_t dataSize, cl_mem gpuBuffer)
+        {
+            cl_int err = clEnqueueWriteBuffer(
+                commandQueue(), gpuBuffer, CL_TRUE, 0, dataSize, src, 0, nullptr, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        void syncReadFromGPU(void * dst, size_t dataSize, cl_mem gpuBuffer)
+        {
+            cl_int err = clEnqueueReadBuffer(
+                commandQueue(), gpuBuffer, CL_TRUE, 0, dataSize, dst, 0, nullptr, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        /// Submits everything enqueued so far, so the devices of a split call start without waiting for each other
+        void flushQueues()
+        {
+            flush(commandQueue());
+            for (auto& queue : pipelineQueues_)
+                flush(queue.get());
+        }
+
+        void copyOnGPU(cl_mem src, cl_mem dst, size_t dataSize)
+        {
+            cl_int err = clEnqueueCopyBuffer(
+                commandQueue(), src, dst, 0, 0, dataSize, 0, nullptr, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+    private:
+        using ContextType = std::remove_reference<decltype(*cl_context())>::type;           // _cl_context
+        using CmdQueueType = std::remove_reference<decltype(*cl_command_queue())>::type;    // _cl_command_queue
+        using ProgramType = std::remove_reference<decltype(*cl_program())>::type;           // _cl_program
+        using KernelType = std::remove_reference<decltype(*cl_kernel())>::type;             // _cl_kernel
+
+        ///
+        class BuiltProgram
+        {
+        public:
+            void setProgram(cl_program prog) { program_ = std::shared_ptr<ProgramType>(prog, clReleaseProgram); }
+            void shareProgram(const BuiltProgram& other) { program_ = other.program_; }
+            void setKernel(cl_kernel kern) { kernel_ = std::shared_ptr<KernelType>(kern, clReleaseKernel); }
+            void setLaunchShape(size_t localSize, uint32_t width) { localSize_ = localSize; width_ = width; }
+
+            cl_program program() { return program_.get(); }
+            cl_kernel kernel() { return kernel_.get(); }
+            size_t localSize() const { return localSize_; }
+            uint32_t width() const { return width_; }
+
+        private:
+            std::shared_ptr<ProgramType> program_;
+            std::shared_ptr<KernelType> kernel_;
+            size_t localSize_ = maxLocalSize();
+            uint32_t width_ = 1;
+        };
+
+        cl_platform_id platform_ = nullptr;
+        cl_device_id device_ = nullptr;
+        std::shared_ptr<ContextType> gpuContext_;
+        std::shared_ptr<CmdQueueType> commandQueue_;
+        std::vector<std::shared_ptr<CmdQueueType>> pipelineQueues_; // extra queues of the chunked pipeline
+        std::unique_ptr<BufferPool> bufferPool_;
+        bool hostUnifiedMemory_ = false;
+        uintptr_t baseAddrAlign_ = 4096; // CL_DEVICE_MEM_BASE_ADDR_ALIGN in bytes
+        ProgramCache programCache_;
+        std::vector<BuiltProgram> programs_; // implicit hash_map<(uint32_t)Kernel::Func, BuiltProgram>
+        std::vector<BuiltProgram> groups_;   // one program per item type, built on first use
+        std::map<std::string, BuiltProgram> fused_; // generated expression kernels by source text
+        std::mutex buildMutex_;
+
+        static constexpr uint32_t sizeAlignment() { return 256; }   // host buffers are padded to it
+        static constexpr uint32_t maxLocalSize() { return 256; }
+        cl_context gpuContext() { return gpuContext_.get(); }
+        cl_command_queue commandQueue() { return commandQueue_.get(); }
+
+        SimdOpenCl(cl_platform_id platform, cl_device_id device)
+        :   platform_(platform),
+            device_(device)
+        {
+            cl_int err = 0;
+            gpuContext_ = std::shared_ptr<ContextType>(
+                clCreateContext(nullptr, 1, &device_, nullptr, nullptr, &err), clReleaseContext);
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            commandQueue_ = std::shared_ptr<CmdQueueType>(createQueue(&err), clReleaseCommandQueue);
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            cl_bool unified = CL_FALSE;
+            err = clGetDeviceInfo(device_, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(unified), &unified, nullptr);
+            hostUnifiedMemory_ = (err == CL_SUCCESS && unified);
+
+            cl_uint alignBits = 0;
+            err = clGetDeviceInfo(device_, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(alignBits), &alignBits, nullptr);
+            if (err == CL_SUCCESS && alignBits >= 8)
+                baseAddrAlign_ = alignBits / 8;
+
+            bufferPool_.reset(new BufferPool(gpuContext()));
+            programCache_.setDevice(platform_, device_);
+            programs_.resize(Kernel::funcCount());
+            groups_.resize(Kernel::groupCount());
+        }
+
+        cl_command_queue createQueue(cl_int * err)
+        {
+#ifdef CL_USE_DEPRECATED_OPENCL_1_2_APIS
+            return clCreateCommandQueue(gpuContext(), device_, 0, err);
+#else
+            return clCreateCommandQueueWithProperties(gpuContext(), device_, nullptr, err);
+#endif
+        }
+
+        /// Kernels are created on first dispatch. The first kernel of an item type compiles
+        /// the whole group, so the compiler runs at most once per type.
+        BuiltProgram& getProgram(Kernel::Func func)
+        {
+            uint32_t idx = static_cast<uint32_t>(func);
+            if (programs_.size() <= idx)
+                throw OCL_EXCEPTION(0);
+
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            BuiltProgram& prog = programs_[idx];
+            if (!prog.kernel())
+                makeKernel(func, prog);
+            return prog;
+        }
+
+        /// The source text is the expression signature: same graph shape and types, same kernel
+        BuiltProgram& getFused(const std::string& text)
+        {
+            std::lock_guard<std::mutex> lock(buildMutex_);
+            BuiltProgram& prog = fused_[text];
+            if (!prog.kernel())
+            {
+                std::string cachePath = programCache_.path(text.c_str(), "");
+                if (!loadProgram(cachePath, "", prog))
+                {
+                    buildFromSource(text.c_str(), "", prog);
+                    storeProgram(cachePath, prog);
+                }
+
+                cl_int err = 0;
+                prog.setKernel(clCreateKernel(prog.program(), "fused", &err));
+                if (err)
+                    throw OCL_EXCEPTION(err);
+                prog.setLaunchShape(tunedLocalSize(prog.kernel()), 1);
+            }
+            return prog;
+        }
+
+        void makeKernel(Kernel::Func func, BuiltProgram& prog)
+        {
+            cl_int err = 0;
+            Kernel::TextProgram srcProg = Kernel::program(func);
+            if (!srcProg.text)
+                throw OCL_EXCEPTION(0);
+
+            BuiltProgram& group = groups_[srcProg.group];
+            if (!group.program())
+                makeGroup(srcProg.group, group);
+
+            prog.shareProgram(group);
+            prog.setKernel(clCreateKernel(prog.program(), srcProg.name, &err));
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            prog.setLaunchShape(tunedLocalSize(prog.kernel()), srcProg.width);
+        }
+
+        /// Largest multiple of the preferred work group size multiple the kernel allows, up to maxLocalSize()
+        size_t tunedLocalSize(cl_kernel kernel)
+        {
+            size_t multiple = 0;
+            size_t maxSize = 0;
+            if (clGetKernelWorkGroupInfo(kernel, device_, CL_KERNEL_PREFERRED_WORK_GROUP_SIZE_MULTIPLE,
+                                         sizeof(multiple), &multiple, nullptr) || !multiple)
+                multiple = 1;
+            if (clGetKernelWorkGroupInfo(kernel, device_, CL_KERNEL_WORK_GROUP_SIZE,
+                                         sizeof(maxSize), &maxSize, nullptr) || !maxSize)
+                maxSize = maxLocalSize();
+
+            size_t cap = std::min<size_t>(maxSize, maxLocalSize());
+            size_t local = cap / multiple * multiple;
+            return local ? local : cap;
+        }
+
+        void makeGroup(uint32_t groupId, BuiltProgram& group)
+        {
+            std::string text = Kernel::groupText(groupId);
+            const char * options = Kernel::groupOptions(groupId);
+
+            std::string cachePath = programCache_.path(text.c_str(), options);
+            if (!loadProgram(cachePath, options, group))
+            {
+                buildFromSource(text.c_str(), options, group);
+                storeProgram(cachePath, group);
+            }
+        }
+
+        void buildFromSource(const char * text, const char * options, BuiltProgram& prog)
+        {
+            cl_int err = 0;
+            size_t progLength = strlen(text);
+
+            prog.setProgram(clCreateProgramWithSource(gpuContext(), 1, &text, &progLength, &err));
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            err = clBuildProgram(prog.program(), 1, &device_, options, nullptr, nullptr);
+            if (err == CL_BUILD_PROGRAM_FAILURE)
+            {
+                size_t size;
+                err = clGetProgramBuildInfo(prog.program(), device_, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size);
+                if (err)
+                    throw OCL_EXCEPTION(err);
+                std::vector<char> info(size);
+                err = clGetProgramBuildInfo(prog.program(), device_, CL_PROGRAM_BUILD_LOG, size, info.data(), nullptr);
+                if (err)
+                    throw OCL_EXCEPTION(err);
+                throw OCL_EXCEPT(CL_BUILD_PROGRAM_FAILURE, info.data());
+            }
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        /// A stale or foreign binary is not an error: the caller rebuilds from source
+        bool loadProgram(const std::string& cachePath, const char * options, BuiltProgram& prog)
+        {
+            std::vector<unsigned char> binary;
+            if (cachePath.empty() || !ProgramCache::load(cachePath, binary))
+                return false;
+
+            const unsigned char * bin = binary.data();
+            size_t binSize = binary.size();
+            cl_int binStatus = 0;
+            cl_int err = 0;
+            cl_program program = clCreateProgramWithBinary(gpuContext(), 1, &device_, &binSize, &bin, &binStatus, &err);
+            if (err || binStatus)
+            {
+                if (program)
+                    clReleaseProgram(program);
+                return false;
+            }
+
+            prog.setProgram(program);
+            return clBuildProgram(prog.program(), 1, &device_, options, nullptr, nullptr) == CL_SUCCESS;
+        }
+
+        void storeProgram(const std::string& cachePath, BuiltProgram& prog)
+        {
+            if (cachePath.empty())
+                return;
+
+            size_t binSize = 0;
+            cl_int err = clGetProgramInfo(prog.program(), CL_PROGRAM_BINARY_SIZES, sizeof(binSize), &binSize, nullptr);
+            if (err || !binSize)
+                return;
+
+            std::vector<unsigned char> binary(binSize);
+            unsigned char * bin = binary.data();
+            err = clGetProgramInfo(prog.program(), CL_PROGRAM_BINARIES, sizeof(bin), &bin, nullptr);
+            if (err)
+                return;
+
+            ProgramCache::store(cachePath, binary);
+        }
+
+        void setArgs(cl_kernel& kernel, cl_mem srcA, cl_mem srcB, cl_mem dst, uint32_t count)
+        {
+            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &srcA);
+            if (srcB)
+                err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &srcB);
+            err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &dst);
+            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &count);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        template <typename _T>
+        void setArgs(cl_kernel& kernel, SrcSrcDstBuffers<_T>& bufs, uint32_t count)
+        {
+            cl_mem srcA = bufs.srcA();
+            cl_mem srcB = bufs.srcB();
+            cl_mem dst = bufs.dst();
+
+            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &srcA);
+            err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &srcB);
+            err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &dst);
+            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &count);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        template <typename _T>
+        void setArgs(cl_kernel& kernel, SrcValDstBuffers<_T>& bufs, uint32_t count)
+        {
+            cl_mem srcA = bufs.srcA();
+            cl_mem dst = bufs.dst();
+
+            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &srcA);
+            //err |= clSetKernelArg(kernel, 1, sizeof(_T), &bufs.srcB);
+            err |= clSetKernelArg(kernel, 2, sizeof(cl_mem), &dst);
+            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &count);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        // The queue is in-order: only the first command waits for foreign events,
+        // and the final read event marks completion of the whole sequence.
+        template <typename _T>
+        cl_event runCoreSequence(const _T * src1, const _T * src2, _T * dst, BuiltProgram& prog, SrcSrcDstBuffers<_T>& bufs,
+                                 int count, const std::vector<cl_event>& waitList)
+        {
+            asyncWriteToGPU(src1, bufs.dataSize(), bufs.srcA(), waitList);
+            asyncWriteToGPU(src2, bufs.dataSize(), bufs.srcB());
+            launchKernel(commandQueue(), prog, count);
+            return asyncReadFromGPU(dst, bufs.dataSize(), bufs.dst());
+        }
+
+        template <typename _T>
+        cl_event runCoreSequence(const _T * src1, _T src2, _T * dst, BuiltProgram& prog, SrcValDstBuffers<_T>& bufs,
+                                 int count, const std::vector<cl_event>& waitList)
+        {
+            cl_int err = clSetKernelArg(prog.kernel(), 1, sizeof(_T), &src2);
+            if (err)
+                throw OCL_EXCEPTION(err);
+
+            asyncWriteToGPU(src1, bufs.dataSize(), bufs.srcA(), waitList);
+            launchKernel(commandQueue(), prog, count);
+            return asyncReadFromGPU(dst, bufs.dataSize(), bufs.dst());
+        }
+
+        /// Each work item handles prog.width() elements
+        void launchKernel(cl_command_queue queue, BuiltProgram& prog, size_t count,
+                          const std::vector<cl_event>& waitList = noEvents())
+        {
+            size_t localWS = prog.localSize();
+            size_t items = (count + prog.width() - 1) / prog.width();
+            size_t workSize = std::max((items + localWS - 1) / localWS, size_t(1)) * localWS;
+
+            cl_int err = clEnqueueNDRangeKernel(queue, prog.kernel(), 1, nullptr, &workSize, &localWS,
+                waitList.size(), waitList.empty() ? nullptr : waitList.data(), nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        template <typename _T>
+        void writeChunk(cl_command_queue queue, const _T * src1, const _T * src2, int offset, int count,
+                        SrcSrcDstBuffers<_T>& bufs, const std::vector<cl_event>& waitList)
+        {
+            asyncWriteToGPU(queue, src1 + offset, count * sizeof(_T), bufs.srcA(), waitList);
+            asyncWriteToGPU(queue, src2 + offset, count * sizeof(_T), bufs.srcB(), noEvents());
+        }
+
+        template <typename _T>
+        void writeChunk(cl_command_queue queue, const _T * src1, _T, int offset, int count,
+                        SrcValDstBuffers<_T>& bufs, const std::vector<cl_event>& waitList)
+        {
+            asyncWriteToGPU(queue, src1 + offset, count * sizeof(_T), bufs.srcA(), waitList);
+        }
+
+        template <typename _T>
+        void setScalarArg(cl_kernel, const _T *)
+        {}
+
+        template <typename _T>
+        void setScalarArg(cl_kernel kernel, _T val)
+        {
+            cl_int err = clSetKernelArg(kernel, 1, sizeof(_T), &val);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        cl_command_queue pipelineQueue(int i)
+        {
+            if (i == 0)
+                return commandQueue();
+
+            while (pipelineQueues_.size() < static_cast<size_t>(i))
+            {
+                cl_int err = 0;
+                pipelineQueues_.push_back(std::shared_ptr<CmdQueueType>(
+                    createQueue(&err), clReleaseCommandQueue));
+                if (err)
+                    throw OCL_EXCEPTION(err);
+            }
+            return pipelineQueues_[i - 1].get();
+        }
+
+        static void flush(cl_command_queue queue)
+        {
+            cl_int err = clFlush(queue);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        static void releaseEvents(std::vector<cl_event>& events)
+        {
+            for (cl_event& ev : events)
+            {
+                if (ev)
+                    clReleaseEvent(ev);
+                ev = nullptr;
+            }
+        }
+
+        static constexpr size_t maxReduceGroups() { return 256; }
+
+        // the in-group tree halves the range at each step
+        static size_t reduceLocalSize(const BuiltProgram& prog)
+        {
+            size_t localWS = 1;
+            while (localWS * 2 <= prog.localSize())
+                localWS *= 2;
+            return localWS;
+        }
+
+        static size_t reduceGroups(int size, size_t localWS)
+        {
+            size_t groups = (std::max(size, 1) + localWS - 1) / localWS;
+            return std::min(groups, maxReduceGroups());
+        }
+
+        template <typename _T>
+        void setReduceArgs(cl_kernel kernel, cl_mem src1, cl_mem src2, _T c, cl_int size, cl_int final,
+                           cl_mem out, size_t scratchSize)
+        {
+            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &src1);
+            err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &src2);
+            err |= clSetKernelArg(kernel, 2, sizeof(_T), &c);
+            err |= clSetKernelArg(kernel, 3, sizeof(cl_int), &size);
+            err |= clSetKernelArg(kernel, 4, sizeof(cl_int), &final);
+            err |= clSetKernelArg(kernel, 5, sizeof(cl_mem), &out);
+            err |= clSetKernelArg(kernel, 6, scratchSize, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        template <typename _T>
+        void setReduceIndxArgs(cl_kernel kernel, cl_mem src, cl_mem srcIdx, cl_int size,
+                               cl_mem outVal, cl_mem outIdx, size_t localWS)
+        {
+            cl_int err = clSetKernelArg(kernel, 0, sizeof(cl_mem), &src);
+            err |= clSetKernelArg(kernel, 1, sizeof(cl_mem), &srcIdx);
+            err |= clSetKernelArg(kernel, 2, sizeof(cl_int), &size);
+            err |= clSetKernelArg(kernel, 3, sizeof(cl_mem), &outVal);
+            err |= clSetKernelArg(kernel, 4, sizeof(cl_mem), &outIdx);
+            err |= clSetKernelArg(kernel, 5, localWS * sizeof(_T), nullptr);
+            err |= clSetKernelArg(kernel, 6, localWS * sizeof(cl_int), nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        void enqueueRange(cl_kernel kernel, size_t globalWS, size_t localWS)
+        {
+            cl_int err = clEnqueueNDRangeKernel(
+                commandQueue(), kernel, 1, nullptr, &globalWS, &localWS, 0, nullptr, nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        static const std::vector<cl_event>& noEvents()
+        {
+            static const std::vector<cl_event> empty;
+            return empty;
+        }
+
+        void asyncWriteToGPU(const void * src, size_t dataSize, cl_mem gpuBuffer,
+                             const std::vector<cl_event>& waitList = noEvents())
+        {
+            asyncWriteToGPU(commandQueue(), src, dataSize, gpuBuffer, waitList);
+        }
+
+        void asyncWriteToGPU(cl_command_queue queue, const void * src, size_t dataSize, cl_mem gpuBuffer,
+                             const std::vector<cl_event>& waitList)
+        {
+            cl_int err = clEnqueueWriteBuffer(
+                queue, gpuBuffer, CL_FALSE, 0, dataSize, src,
+                waitList.size(), waitList.empty() ? nullptr : waitList.data(), nullptr);
+            if (err)
+                throw OCL_EXCEPTION(err);
+        }
+
+        cl_event asyncReadFromGPU(void * dst, size_t dataSize, cl_mem gpuBuffer)
+        {
+            return asyncReadFromGPU(commandQueue(), dst, dataSize, gpuBuffer);
+        }
+
+        cl_event asyncReadFromGPU(cl_command_queue queue, void * dst, size_t dataSize, cl_mem gpuBuffer)
+        {
+            cl_event done = nullptr;
+            cl_int err = clEnqueueReadBuffer(
+                queue, gpuBuffer, CL_FALSE, 0, dataSize, dst, 0, nullptr, &done);
+            if (err)
+                throw OCL_EXCEPTION(err);
+            return done;
+        }
+    };
+
+    int alignedSize(int len)
+    {
         return SimdOpenCl::alignedSize(len);
     }
 
-    template <typename _KernelT, typename _T>
-    void execKernel(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+    // 4096 is what zero-copy CL_MEM_USE_HOST_PTR expects on most integrated GPUs
+    static constexpr size_t hostAlignment() { return 4096; }
+
+    void * hostAlloc(size_t dataSize)
+    {
+        size_t padded = (dataSize + 63) / 64 * 64;
+#ifdef _WIN32
+        void * ptr = _aligned_malloc(padded, hostAlignment());
+#else
+        void * ptr = nullptr;
+        if (posix_memalign(&ptr, hostAlignment(), padded))
+            ptr = nullptr;
+#endif
+        if (!ptr)
+            throw std::bad_alloc();
+        return ptr;
+    }
+
+    void hostFree(void * ptr)
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        ::free(ptr);
+#endif
+    }
+
+    /// Shared state of a DeviceGroup
+    class GroupState
+    {
+    public:
+        explicit GroupState(const std::vector<Context>& contexts)
+        :   contexts_(contexts)
+        {
+            if (contexts_.empty())
+                throw OCL_EXCEPT(CL_INVALID_VALUE, "empty DeviceGroup");
+        }
+
+        const std::vector<Context>& contexts() const { return contexts_; }
+
+        std::vector<double> weights()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (weights_.empty())
+                weights_ = normalized(measure());
+            return weights_;
+        }
+
+        void setWeights(const std::vector<double>& weights)
+        {
+            if (weights.size() != contexts_.size())
+                throw OCL_EXCEPT(CL_INVALID_VALUE, "one weight per device expected");
+
+            std::vector<double> w = normalized(weights);
+            std::lock_guard<std::mutex> lock(mutex_);
+            weights_ = w;
+        }
+
+        void calibrate() { setWeights(measure()); }
+
+        int minLength = 1 << 22;
+
+        /// Contiguous slices in device order, multiples of the host padding except the last one
+        std::vector<int> split(int len)
+        {
+            std::vector<double> w = weights();
+            std::vector<int> slices(w.size(), 0);
+            if (len < minLength)
+            {
+                slices[std::max_element(w.begin(), w.end()) - w.begin()] = len;
+                return slices;
+            }
+
+            int rest = len;
+            for (size_t i = 0; i + 1 < w.size() && rest; ++i)
+            {
+                int n = std::min(alignedSize(static_cast<int>(len * w[i])), rest);
+                slices[i] = n;
+                rest -= n;
+            }
+            slices.back() += rest;
+            return slices;
+        }
+
+        /// Set by DeviceGroupScope
+        static GroupState *& current()
+        {
+            static thread_local GroupState * cur = nullptr;
+            return cur;
+        }
+
+    private:
+        std::vector<Context> contexts_;
+        std::vector<double> weights_;
+        std::mutex mutex_;
+
+        /// Large-call throughput of every device, transfers included
+        std::vector<double> measure() const
+        {
+            // the timed calls must not be split themselves
+            struct NoGroup
+            {
+                GroupState * prev = current();
+                NoGroup() { current() = nullptr; }
+                ~NoGroup() { current() = prev; }
+            } noGroup;
+
+            std::vector<double> rates;
+            for (const Context& ctx : contexts_)
+            {
+                ContextScope scope(ctx);
+                rates.push_back(measureTransferCost().bytesPerSecond);
+            }
+            return rates;
+        }
+
+        static std::vector<double> normalized(std::vector<double> w)
+        {
+            double total = 0;
+            for (double& x : w)
+                total += (x = std::max(x, 0.));
+            for (double& x : w)
+                x = (total > 0) ? x / total : 1. / w.size();
+            return w;
+        }
+    };
+
+    template <typename _T>
+    inline const _T * sliceOf(const _T * ptr, int offset) { return ptr + offset; }
+
+    template <typename _T>
+    inline _T sliceOf(_T val, int) { return val; }
+
+    /// Every device runs its slice through its own queues and buffer pool and reads back into its part of dst.
+    /// Events to wait for may come from any context, so the host waits for them first.
+    template <typename _KernelT>
+    Event execSplit(GroupState& group, typename _KernelT::DataTypeSrc1 src1, typename _KernelT::DataTypeSrc2 src2,
+                    typename _KernelT::DataTypeDst dst, int len, const EventList& waitFor)
+    {
+        for (const Event& ev : waitFor)
+            ev.wait();
+
+        std::vector<int> slices = group.split(len);
+        EventList parts;
+        int offset = 0;
+        for (size_t i = 0; i < slices.size(); ++i)
+        {
+            if (!slices[i])
+                continue;
+
+            SimdOpenCl& dev = group.contexts()[i].impl();
+            parts.push_back(dev.exec<_KernelT>(src1 + offset, sliceOf(src2, offset), dst + offset, slices[i], EventList()));
+            dev.flushQueues();
+            offset += slices[i];
+        }
+
+        if (parts.size() == 1)
+            return parts[0];
+        return Event(std::make_shared<EventState>(parts));
+    }
+
+    template <typename _KernelT, typename _T>
+    Event execAsync(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, const EventList& waitFor)
+    {
+        if (GroupState * group = GroupState::current())
+            return execSplit<_KernelT>(*group, pSrc1, pSrc2, pDst, len, waitFor);
+        return SimdOpenCl::getInstance().exec<_KernelT>(pSrc1, pSrc2, pDst, len, waitFor);
+    }
+
+    template <typename _KernelT, typename _T>
+    Event execAsync(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
+    {
+        if (GroupState * group = GroupState::current())
+            return execSplit<_KernelT>(*group, pSrc, val, pDst, len, waitFor);
+        return SimdOpenCl::getInstance().exec<_KernelT>(pSrc, val, pDst, len, waitFor);
+    }
+
+    template <typename _KernelT, typename _T>
+    void execKernel(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+    {
+        execAsync<_KernelT>(pSrc1, pSrc2, pDst, len, EventList()).wait();
+    }
+
+    template <typename _KernelT, typename _T>
+    void execKernel(const _T * pSrc, _T val, _T * pDst, int len)
+    {
+        execAsync<_KernelT>(pSrc, val, pDst, len, EventList()).wait();
+    }
+
+    /// Makes the calling thread's current context `ctx` for its lifetime
+    class CurrentGuard
+    {
+    public:
+        explicit CurrentGuard(SimdOpenCl * ctx)
+        :   prev_(SimdOpenCl::current())
+        {
+            SimdOpenCl::current() = ctx;
+        }
+
+        ~CurrentGuard() { SimdOpenCl::current() = prev_; }
+
+    private:
+        SimdOpenCl * prev_;
+    };
+
+    /// dst is (re)allocated in the context that owns src
+    template <typename _T>
+    void prepareDst(const DeviceArray<_T>& src, DeviceArray<_T>& dst)
+    {
+        SimdOpenCl& owner = src.buffer()->owner();
+        if (dst.size() != src.size() || !dst.buffer() || &dst.buffer()->owner() != &owner)
+        {
+            CurrentGuard guard(&owner);
+            dst = DeviceArray<_T>(src.size());
+        }
+    }
+
+    template <typename _KernelT, typename _T>
+    void execKernel(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst)
+    {
+        if (src1.size() != src2.size())
+            throw OCL_EXCEPT(CL_INVALID_VALUE, "DeviceArray size mismatch");
+        if (src1.empty())
+            return;
+
+        if (&src1.buffer()->owner() != &src2.buffer()->owner())
+            throw OCL_EXCEPT(CL_INVALID_CONTEXT, "DeviceArrays from different contexts");
+
+        prepareDst(src1, dst);
+        src1.buffer()->owner().template execOnDevice<_KernelT>(
+            src1.buffer()->mem(), src2.buffer()->mem(), dst.buffer()->mem(), src1.size());
+    }
+
+    template <typename _KernelT, typename _T>
+    void execKernel(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
+    {
+        if (src.empty())
+            return;
+
+        prepareDst(src, dst);
+        src.buffer()->owner().template execOnDevice<_KernelT>(src.buffer()->mem(), val, dst.buffer()->mem(), src.size());
+    }
+
+    // an empty array reduces to 0, as the host sums and norms do for len == 0
+    template <typename _KernelT, typename _T>
+    _T reduce(const DeviceArray<_T>& src, _T c = _T(0))
+    {
+        if (src.empty())
+            return _T(0);
+        return src.buffer()->owner().template reduce<_KernelT>(src.buffer()->mem(), nullptr, c, src.size());
+    }
+
+    template <typename _KernelT, typename _T>
+    _T reduce(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2)
+    {
+        if (src1.size() != src2.size())
+            throw OCL_EXCEPT(CL_INVALID_VALUE, "DeviceArray size mismatch");
+        if (src1.empty())
+            return _T(0);
+        if (&src1.buffer()->owner() != &src2.buffer()->owner())
+            throw OCL_EXCEPT(CL_INVALID_CONTEXT, "DeviceArrays from different contexts");
+
+        return src1.buffer()->owner().template reduce<_KernelT>(
+            src1.buffer()->mem(), src2.buffer()->mem(), _T(0), src1.size());
+    }
+
+    template <typename _KernelT, typename _T>
+    _T reduceIndx(const DeviceArray<_T>& src, int * pIndx)
+    {
+        return src.buffer()->owner().template reduceIndx<_KernelT>(src.buffer()->mem(), src.size(), pIndx);
+    }
+
+    template <typename _T>
+    void requireData(const DeviceArray<_T>& src)
+    {
+        if (src.empty())
+            throw OCL_EXCEPT(CL_INVALID_VALUE, "empty DeviceArray");
+    }
+
+    /// Kernel source of an expression graph. Every node is emitted once, so a shared subexpression
+    /// is computed once per element and an array used twice is loaded once.
+    template <typename _T>
+    class FusedKernel
+    {
+    public:
+        using Node = ExprNode<_T>;
+
+        explicit FusedKernel(const Node& root)
+        {
+            std::string result = visit(&root);
+
+            text_ = "__kernel void fused(";
+            for (size_t i = 0; i < inputs_.size(); ++i)
+                text_ += std::string("__global const ") + item() + "* a" + std::to_string(i) + ", ";
+            for (size_t i = 0; i < scalars_.size(); ++i)
+                text_ += std::string(item()) + " c" + std::to_string(i) + ", ";
+            text_ += std::string("__global ") + item() + "* out, int size) {";
+            text_ += " int i = get_global_id(0); if (i >= size) return;";
+            text_ += body_;
+            text_ += " out[i] = " + result + "; }";
+        }
+
+        const std::string& text() const { return text_; }
+        const std::vector<const DeviceArray<_T>*>& inputs() const { return inputs_; }
+        const std::vector<_T>& scalars() const { return scalars_; }
+
+    private:
+        std::string text_;
+        std::string body_;
+        std::vector<const DeviceArray<_T>*> inputs_;
+        std::vector<std::string> loads_; // temporaries holding inputs_[k][i]
+        std::vector<_T> scalars_;
+        std::map<const Node*, std::string> names_;
+        uint32_t temps_ = 0;
+
+        static const char * item() { return Kernel::TextProgram::typeStr<_T>(); }
+
+        std::string visit(const Node * node)
+        {
+            auto it = names_.find(node);
+            if (it != names_.end())
+                return it->second;
+
+            std::string name;
+            switch (node->kind)
+            {
+                case Node::Input:
+                    name = input(node->array);
+                    break;
+                case Node::Scalar:
+                    name = "c" + std::to_string(scalars_.size());
+                    scalars_.push_back(node->value);
+                    break;
+                case Node::Unary:
+                    name = temp(std::string(node->op) + "(" + visit(node->left.get()) + ")");
+                    break;
+                case Node::Binary:
+                {
+                    std::string l = visit(node->left.get());
+                    std::string r = visit(node->right.get());
+                    name = temp("(" + l + " " + node->op + " " + r + ")");
+                    break;
+                }
+                case Node::Call2:
+                {
+                    std::string l = visit(node->left.get());
+                    std::string r = visit(node->right.get());
+                    name = temp(std::string(node->op) + "(" + l + ", " + r + ")");
+                    break;
+                }
+            }
+
+            names_[node] = name;
+            return name;
+        }
+
+        /// Arrays sharing device memory are one kernel argument
+        std::string input(const DeviceArray<_T>& array)
+        {
+            for (size_t i = 0; i < inputs_.size(); ++i)
+                if (inputs_[i]->buffer() == array.buffer())
+                    return loads_[i];
+
+            loads_.push_back(temp("a" + std::to_string(inputs_.size()) + "[i]"));
+            inputs_.push_back(&array);
+            return loads_.back();
+        }
+
+        std::string temp(const std::string& expr)
+        {
+            std::string name = "t" + std::to_string(temps_++);
+            body_ += std::string(" ") + item() + " " + name + " = " + expr + ";";
+            return name;
+        }
+    };
+
+} // internals
+
+namespace arithmetic
+{
+    // int8_t
+
+    _SIMD_OCL_SPEC void addC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<int8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<int8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<int8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<int8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<int8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const int8_t * pSrc, int8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<int8_t>>(pSrc, int8_t(0), pDst, len);
+    }
+
+    // uint16_t
+
+    _SIMD_OCL_SPEC void addC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<uint8_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<uint8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<uint8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<uint8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<uint8_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const uint8_t * pSrc, uint8_t * pDst, int len)
+    {
+        if (pSrc != pDst)
+            copy(pSrc, pDst, len);
+    }
+
+    // int16_t
+
+    _SIMD_OCL_SPEC void addC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<int16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<int16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<int16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<int16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<int16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const int16_t * pSrc, int16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<int16_t>>(pSrc, int16_t(0), pDst, len);
+    }
+
+    // uint16_t
+
+    _SIMD_OCL_SPEC void addC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<uint16_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<uint16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<uint16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<uint16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<uint16_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const uint16_t * pSrc, uint16_t * pDst, int len)
+    {
+        if (pSrc != pDst)
+            copy(pSrc, pDst, len);
+    }
+
+    // int32_t
+
+    _SIMD_OCL_SPEC void addC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<int32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<int32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<int32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<int32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<int32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const int32_t * pSrc, int32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<int32_t>>(pSrc, 0, pDst, len);
+    }
+
+    // uint32_t
+
+    _SIMD_OCL_SPEC void addC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<uint32_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<uint32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<uint32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<uint32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<uint32_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const uint32_t * pSrc, uint32_t * pDst, int len)
+    {
+        if (pSrc != pDst)
+            copy(pSrc, pDst, len);
+    }
+
+    // int64_t
+
+    _SIMD_OCL_SPEC void addC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<int64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<int64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<int64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
-        SimdOpenCl::getInstance().exec<_KernelT>(pSrc1, pSrc2, pDst, len);
+        internals::execKernel<internals::Kernel::DivC<int64_t>>(pSrc, val, pDst, len);
     }
 
-    template <typename _KernelT, typename _T>
-    void execKernel(const _T * pSrc, _T val, _T * pDst, int len)
+    _SIMD_OCL_SPEC void subCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
-        SimdOpenCl::getInstance().exec<_KernelT>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::SubCRev<int64_t>>(pSrc, val, pDst, len);
     }
 
-} // internals
+    _SIMD_OCL_SPEC void divCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<int64_t>>(pSrc, val, pDst, len);
+    }
 
-namespace arithmetic
+    _SIMD_OCL_SPEC void add(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<int64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<int64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<int64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<int64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const int64_t * pSrc, int64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<int64_t>>(pSrc, 0l, pDst, len);
+    }
+
+    // uint64_t
+
+    _SIMD_OCL_SPEC void addC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<uint64_t>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<uint64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<uint64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<uint64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<uint64_t>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const uint64_t * pSrc, uint64_t * pDst, int len)
+    {
+        if (pSrc != pDst)
+            copy(pSrc, pDst, len);
+    }
+
+    // float
+
+    _SIMD_OCL_SPEC void addC(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const float * pSrc, float val, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<float>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<float>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<float>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<float>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<float>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const float * pSrc, float * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<float>>(pSrc, 0.0f, pDst, len);
+    }
+
+    // double
+
+    _SIMD_OCL_SPEC void addC(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::AddC<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subC(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubC<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mulC(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::MulC<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divC(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivC<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void subCRev(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::SubCRev<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void divCRev(const double * pSrc, double val, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::DivCRev<double>>(pSrc, val, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void add(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Add<double>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void sub(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Sub<double>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void mul(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Mul<double>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void div(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Div<double>>(pSrc1, pSrc2, pDst, len);
+    }
+
+    _SIMD_OCL_SPEC void abs(const double * pSrc, double * pDst, int len)
+    {
+        internals::execKernel<internals::Kernel::Abs<double>>(pSrc, 0.0, pDst, len);
+    }
+}
+
+namespace statistical
 {
-    // int8_t
+    // host arrays: float and double are uploaded once and reduced on the device
 
-    _SIMD_OCL_SPEC void addC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_T void min(const _T * pSrc, int len, _T * pMin)
     {
-        internals::execKernel<internals::Kernel::AddC<int8_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::min(pSrc, len, pMin);
     }
 
-    _SIMD_OCL_SPEC void subC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void min(const float * pSrc, int len, float * pMin)
     {
-        internals::execKernel<internals::Kernel::SubC<int8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::min(pSrc, len, pMin);
+        min(DeviceArray<float>(pSrc, len), pMin);
+    }
+
+    _SIMD_OCL_SPEC void min(const double * pSrc, int len, double * pMin)
+    {
+        if (len <= 0)
+            return nosimd::statistical::min(pSrc, len, pMin);
+        min(DeviceArray<double>(pSrc, len), pMin);
+    }
+
+    _SIMD_OCL_T void max(const _T * pSrc, int len, _T * pMax)
+    {
+        nosimd::statistical::max(pSrc, len, pMax);
+    }
+
+    _SIMD_OCL_SPEC void max(const float * pSrc, int len, float * pMax)
+    {
+        if (len <= 0)
+            return nosimd::statistical::max(pSrc, len, pMax);
+        max(DeviceArray<float>(pSrc, len), pMax);
+    }
+
+    _SIMD_OCL_SPEC void max(const double * pSrc, int len, double * pMax)
+    {
+        if (len <= 0)
+            return nosimd::statistical::max(pSrc, len, pMax);
+        max(DeviceArray<double>(pSrc, len), pMax);
+    }
+
+    _SIMD_OCL_T void sum(const _T * pSrc, int len, _T * pSum)
+    {
+        nosimd::statistical::sum(pSrc, len, pSum);
+    }
+
+    _SIMD_OCL_SPEC void sum(const float * pSrc, int len, float * pSum)
+    {
+        if (len <= 0)
+            return nosimd::statistical::sum(pSrc, len, pSum);
+        sum(DeviceArray<float>(pSrc, len), pSum);
+    }
+
+    _SIMD_OCL_SPEC void sum(const double * pSrc, int len, double * pSum)
+    {
+        if (len <= 0)
+            return nosimd::statistical::sum(pSrc, len, pSum);
+        sum(DeviceArray<double>(pSrc, len), pSum);
+    }
+
+    _SIMD_OCL_T void normInf(const _T * pSrc, int len, _T * pNorm)
+    {
+        nosimd::statistical::normInf(pSrc, len, pNorm);
+    }
+
+    _SIMD_OCL_SPEC void normInf(const float * pSrc, int len, float * pNorm)
+    {
+        if (len <= 0)
+            return nosimd::statistical::normInf(pSrc, len, pNorm);
+        normInf(DeviceArray<float>(pSrc, len), pNorm);
+    }
+
+    _SIMD_OCL_SPEC void normInf(const double * pSrc, int len, double * pNorm)
+    {
+        if (len <= 0)
+            return nosimd::statistical::normInf(pSrc, len, pNorm);
+        normInf(DeviceArray<double>(pSrc, len), pNorm);
+    }
+
+    _SIMD_OCL_T void normL1(const _T * pSrc, int len, _T * pNorm)
+    {
+        nosimd::statistical::normL1(pSrc, len, pNorm);
+    }
+
+    _SIMD_OCL_SPEC void normL1(const float * pSrc, int len, float * pNorm)
+    {
+        if (len <= 0)
+            return nosimd::statistical::normL1(pSrc, len, pNorm);
+        normL1(DeviceArray<float>(pSrc, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void mulC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void normL1(const double * pSrc, int len, double * pNorm)
     {
-        internals::execKernel<internals::Kernel::MulC<int8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normL1(pSrc, len, pNorm);
+        normL1(DeviceArray<double>(pSrc, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void divC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_T void normL2(const _T * pSrc, int len, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::DivC<int8_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::normL2(pSrc, len, pNorm);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void normL2(const float * pSrc, int len, float * pNorm)
     {
-        internals::execKernel<internals::Kernel::SubCRev<int8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normL2(pSrc, len, pNorm);
+        normL2(DeviceArray<float>(pSrc, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void normL2(const double * pSrc, int len, double * pNorm)
     {
-        internals::execKernel<internals::Kernel::DivCRev<int8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normL2(pSrc, len, pNorm);
+        normL2(DeviceArray<double>(pSrc, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void add(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    _SIMD_OCL_T void minMax(const _T * pSrc, int len, _T * pMin, _T * pMax)
     {
-        internals::execKernel<internals::Kernel::Add<int8_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::statistical::minMax(pSrc, len, pMin, pMax);
     }
 
-    _SIMD_OCL_SPEC void sub(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minMax(const float * pSrc, int len, float * pMin, float * pMax)
     {
-        internals::execKernel<internals::Kernel::Sub<int8_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minMax(pSrc, len, pMin, pMax);
+        minMax(DeviceArray<float>(pSrc, len), pMin, pMax);
     }
 
-    _SIMD_OCL_SPEC void mul(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minMax(const double * pSrc, int len, double * pMin, double * pMax)
     {
-        internals::execKernel<internals::Kernel::Mul<int8_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minMax(pSrc, len, pMin, pMax);
+        minMax(DeviceArray<double>(pSrc, len), pMin, pMax);
     }
 
-    _SIMD_OCL_SPEC void div(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    _SIMD_OCL_T void minIndx(const _T * pSrc, int len, _T * pMin, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::Div<int8_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::statistical::minIndx(pSrc, len, pMin, pIndx);
     }
 
-    _SIMD_OCL_SPEC void abs(const int8_t * pSrc, int8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minIndx(const float * pSrc, int len, float * pMin, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::Abs<int8_t>>(pSrc, int8_t(0), pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minIndx(pSrc, len, pMin, pIndx);
+        minIndx(DeviceArray<float>(pSrc, len), pMin, pIndx);
     }
 
-    // uint16_t
-
-    _SIMD_OCL_SPEC void addC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minIndx(const double * pSrc, int len, double * pMin, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::AddC<uint8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minIndx(pSrc, len, pMin, pIndx);
+        minIndx(DeviceArray<double>(pSrc, len), pMin, pIndx);
     }
 
-    _SIMD_OCL_SPEC void subC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_T void maxIndx(const _T * pSrc, int len, _T * pMax, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::SubC<uint8_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::maxIndx(pSrc, len, pMax, pIndx);
     }
 
-    _SIMD_OCL_SPEC void mulC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void maxIndx(const float * pSrc, int len, float * pMax, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::MulC<uint8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::maxIndx(pSrc, len, pMax, pIndx);
+        maxIndx(DeviceArray<float>(pSrc, len), pMax, pIndx);
     }
 
-    _SIMD_OCL_SPEC void divC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void maxIndx(const double * pSrc, int len, double * pMax, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::DivC<uint8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::maxIndx(pSrc, len, pMax, pIndx);
+        maxIndx(DeviceArray<double>(pSrc, len), pMax, pIndx);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_T void minMaxIndx(const _T * pSrc, int len, _T * pMin, int * pMinIndx, _T * pMax, int * pMaxIndx)
     {
-        internals::execKernel<internals::Kernel::SubCRev<uint8_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::minMaxIndx(pSrc, len, pMin, pMinIndx, pMax, pMaxIndx);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minMaxIndx(const float * pSrc, int len, float * pMin, int * pMinIndx, float * pMax, int * pMaxIndx)
     {
-        internals::execKernel<internals::Kernel::DivCRev<uint8_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minMaxIndx(pSrc, len, pMin, pMinIndx, pMax, pMaxIndx);
+        minMaxIndx(DeviceArray<float>(pSrc, len), pMin, pMinIndx, pMax, pMaxIndx);
     }
 
-    _SIMD_OCL_SPEC void add(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void minMaxIndx(const double * pSrc, int len, double * pMin, int * pMinIndx, double * pMax, int * pMaxIndx)
     {
-        internals::execKernel<internals::Kernel::Add<uint8_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::minMaxIndx(pSrc, len, pMin, pMinIndx, pMax, pMaxIndx);
+        minMaxIndx(DeviceArray<double>(pSrc, len), pMin, pMinIndx, pMax, pMaxIndx);
     }
 
-    _SIMD_OCL_SPEC void sub(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    _SIMD_OCL_T void meanStdDev(const _T * pSrc, int len, _T * pMean, _T * pStdDev)
     {
-        internals::execKernel<internals::Kernel::Sub<uint8_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
     }
 
-    _SIMD_OCL_SPEC void mul(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void meanStdDev(const float * pSrc, int len, float * pMean, float * pStdDev)
     {
-        internals::execKernel<internals::Kernel::Mul<uint8_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
+        meanStdDev(DeviceArray<float>(pSrc, len), pMean, pStdDev);
     }
 
-    _SIMD_OCL_SPEC void div(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    _SIMD_OCL_SPEC void meanStdDev(const double * pSrc, int len, double * pMean, double * pStdDev)
     {
-        internals::execKernel<internals::Kernel::Div<uint8_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
+        meanStdDev(DeviceArray<double>(pSrc, len), pMean, pStdDev);
     }
 
-    _SIMD_OCL_SPEC void abs(const uint8_t * pSrc, uint8_t * pDst, int len)
+    _SIMD_OCL_T void dotProd(const _T * pSrc1, const _T * pSrc2, int len, _T * pDp)
     {
-        if (pSrc != pDst)
-            copy(pSrc, pDst, len);
+        nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
     }
 
-    // int16_t
-
-    _SIMD_OCL_SPEC void addC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void dotProd(const float * pSrc1, const float * pSrc2, int len, float * pDp)
     {
-        internals::execKernel<internals::Kernel::AddC<int16_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        dotProd(DeviceArray<float>(pSrc1, len), DeviceArray<float>(pSrc2, len), pDp);
     }
 
-    _SIMD_OCL_SPEC void subC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void dotProd(const double * pSrc1, const double * pSrc2, int len, double * pDp)
     {
-        internals::execKernel<internals::Kernel::SubC<int16_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        dotProd(DeviceArray<double>(pSrc1, len), DeviceArray<double>(pSrc2, len), pDp);
     }
 
-    _SIMD_OCL_SPEC void mulC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_T void normDiffInf(const _T * pSrc1, const _T * pSrc2, int len, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::MulC<int16_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::normDiffInf(pSrc1, pSrc2, len, pNorm);
     }
 
-    _SIMD_OCL_SPEC void divC(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffInf(const float * pSrc1, const float * pSrc2, int len, float * pNorm)
     {
-        internals::execKernel<internals::Kernel::DivC<int16_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffInf(pSrc1, pSrc2, len, pNorm);
+        normDiffInf(DeviceArray<float>(pSrc1, len), DeviceArray<float>(pSrc2, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffInf(const double * pSrc1, const double * pSrc2, int len, double * pNorm)
     {
-        internals::execKernel<internals::Kernel::SubCRev<int16_t>>(pSrc, val, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffInf(pSrc1, pSrc2, len, pNorm);
+        normDiffInf(DeviceArray<double>(pSrc1, len), DeviceArray<double>(pSrc2, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const int16_t * pSrc, int16_t val, int16_t * pDst, int len)
+    _SIMD_OCL_T void normDiffL1(const _T * pSrc1, const _T * pSrc2, int len, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::DivCRev<int16_t>>(pSrc, val, pDst, len);
+        nosimd::statistical::normDiffL1(pSrc1, pSrc2, len, pNorm);
     }
 
-    _SIMD_OCL_SPEC void add(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffL1(const float * pSrc1, const float * pSrc2, int len, float * pNorm)
     {
-        internals::execKernel<internals::Kernel::Add<int16_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffL1(pSrc1, pSrc2, len, pNorm);
+        normDiffL1(DeviceArray<float>(pSrc1, len), DeviceArray<float>(pSrc2, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void sub(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffL1(const double * pSrc1, const double * pSrc2, int len, double * pNorm)
     {
-        internals::execKernel<internals::Kernel::Sub<int16_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffL1(pSrc1, pSrc2, len, pNorm);
+        normDiffL1(DeviceArray<double>(pSrc1, len), DeviceArray<double>(pSrc2, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void mul(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    _SIMD_OCL_T void normDiffL2(const _T * pSrc1, const _T * pSrc2, int len, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::Mul<int16_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::statistical::normDiffL2(pSrc1, pSrc2, len, pNorm);
     }
 
-    _SIMD_OCL_SPEC void div(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffL2(const float * pSrc1, const float * pSrc2, int len, float * pNorm)
     {
-        internals::execKernel<internals::Kernel::Div<int16_t>>(pSrc1, pSrc2, pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffL2(pSrc1, pSrc2, len, pNorm);
+        normDiffL2(DeviceArray<float>(pSrc1, len), DeviceArray<float>(pSrc2, len), pNorm);
     }
 
-    _SIMD_OCL_SPEC void abs(const int16_t * pSrc, int16_t * pDst, int len)
+    _SIMD_OCL_SPEC void normDiffL2(const double * pSrc1, const double * pSrc2, int len, double * pNorm)
     {
-        internals::execKernel<internals::Kernel::Abs<int16_t>>(pSrc, int16_t(0), pDst, len);
+        if (len <= 0)
+            return nosimd::statistical::normDiffL2(pSrc1, pSrc2, len, pNorm);
+        normDiffL2(DeviceArray<double>(pSrc1, len), DeviceArray<double>(pSrc2, len), pNorm);
     }
 
-    // uint16_t
+    // device arrays
 
-    _SIMD_OCL_SPEC void addC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void min(const DeviceArray<_T>& src, _T * pMin)
     {
-        internals::execKernel<internals::Kernel::AddC<uint16_t>>(pSrc, val, pDst, len);
+        internals::requireData(src);
+        *pMin = internals::reduce<internals::Kernel::ReduceMin<_T>>(src);
     }
 
-    _SIMD_OCL_SPEC void subC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void max(const DeviceArray<_T>& src, _T * pMax)
     {
-        internals::execKernel<internals::Kernel::SubC<uint16_t>>(pSrc, val, pDst, len);
+        internals::requireData(src);
+        *pMax = internals::reduce<internals::Kernel::ReduceMax<_T>>(src);
     }
 
-    _SIMD_OCL_SPEC void mulC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void minMax(const DeviceArray<_T>& src, _T * pMin, _T * pMax)
     {
-        internals::execKernel<internals::Kernel::MulC<uint16_t>>(pSrc, val, pDst, len);
+        min(src, pMin);
+        max(src, pMax);
     }
 
-    _SIMD_OCL_SPEC void divC(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void minIndx(const DeviceArray<_T>& src, _T * pMin, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::DivC<uint16_t>>(pSrc, val, pDst, len);
+        internals::requireData(src);
+        *pMin = internals::reduceIndx<internals::Kernel::ReduceMinIndx<_T>>(src, pIndx);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void maxIndx(const DeviceArray<_T>& src, _T * pMax, int * pIndx)
     {
-        internals::execKernel<internals::Kernel::SubCRev<uint16_t>>(pSrc, val, pDst, len);
+        internals::requireData(src);
+        *pMax = internals::reduceIndx<internals::Kernel::ReduceMaxIndx<_T>>(src, pIndx);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const uint16_t * pSrc, uint16_t val, uint16_t * pDst, int len)
+    _SIMD_OCL_T void minMaxIndx(const DeviceArray<_T>& src, _T * pMin, int * pMinIndx, _T * pMax, int * pMaxIndx)
     {
-        internals::execKernel<internals::Kernel::DivCRev<uint16_t>>(pSrc, val, pDst, len);
+        minIndx(src, pMin, pMinIndx);
+        maxIndx(src, pMax, pMaxIndx);
     }
 
-    _SIMD_OCL_SPEC void add(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    _SIMD_OCL_T void sum(const DeviceArray<_T>& src, _T * pSum)
     {
-        internals::execKernel<internals::Kernel::Add<uint16_t>>(pSrc1, pSrc2, pDst, len);
+        *pSum = internals::reduce<internals::Kernel::ReduceSum<_T>>(src);
     }
 
-    _SIMD_OCL_SPEC void sub(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    // two passes over device data, as exact as the host version
+    _SIMD_OCL_T void meanStdDev(const DeviceArray<_T>& src, _T * pMean, _T * pStdDev)
     {
-        internals::execKernel<internals::Kernel::Sub<uint16_t>>(pSrc1, pSrc2, pDst, len);
+        internals::requireData(src);
+        _T mean = internals::reduce<internals::Kernel::ReduceSum<_T>>(src) / src.size();
+        _T sqDev = internals::reduce<internals::Kernel::ReduceSqDev<_T>>(src, mean);
+        *pMean = mean;
+        *pStdDev = std::sqrt(sqDev / (src.size() - 1));
     }
 
-    _SIMD_OCL_SPEC void mul(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    _SIMD_OCL_T void dotProd(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T * pDp)
     {
-        internals::execKernel<internals::Kernel::Mul<uint16_t>>(pSrc1, pSrc2, pDst, len);
+        *pDp = internals::reduce<internals::Kernel::ReduceDot<_T>>(src1, src2);
     }
 
-    _SIMD_OCL_SPEC void div(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len)
+    _SIMD_OCL_T void normInf(const DeviceArray<_T>& src, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::Div<uint16_t>>(pSrc1, pSrc2, pDst, len);
+        *pNorm = internals::reduce<internals::Kernel::ReduceInf<_T>>(src);
     }
 
-    _SIMD_OCL_SPEC void abs(const uint16_t * pSrc, uint16_t * pDst, int len)
+    _SIMD_OCL_T void normL1(const DeviceArray<_T>& src, _T * pNorm)
     {
-        if (pSrc != pDst)
-            copy(pSrc, pDst, len);
+        *pNorm = internals::reduce<internals::Kernel::ReduceL1<_T>>(src);
     }
 
-    // int32_t
-
-    _SIMD_OCL_SPEC void addC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    _SIMD_OCL_T void normL2(const DeviceArray<_T>& src, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::AddC<int32_t>>(pSrc, val, pDst, len);
+        *pNorm = std::sqrt(internals::reduce<internals::Kernel::ReduceSqDev<_T>>(src));
     }
 
-    _SIMD_OCL_SPEC void subC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    _SIMD_OCL_T void normDiffInf(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::SubC<int32_t>>(pSrc, val, pDst, len);
+        *pNorm = internals::reduce<internals::Kernel::ReduceDiffInf<_T>>(src1, src2);
     }
 
-    _SIMD_OCL_SPEC void mulC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    _SIMD_OCL_T void normDiffL1(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::MulC<int32_t>>(pSrc, val, pDst, len);
+        *pNorm = internals::reduce<internals::Kernel::ReduceDiffL1<_T>>(src1, src2);
     }
 
-    _SIMD_OCL_SPEC void divC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+    _SIMD_OCL_T void normDiffL2(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T * pNorm)
     {
-        internals::execKernel<internals::Kernel::DivC<int32_t>>(pSrc, val, pDst, len);
+        *pNorm = std::sqrt(internals::reduce<internals::Kernel::ReduceDiffL2<_T>>(src1, src2));
     }
+}
 
-    _SIMD_OCL_SPEC void subCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
+#define OCL_INSTANTIATE_STATISTICAL_HOST(T) \
+    template void statistical::min(const T *, int, T *); \
+    template void statistical::max(const T *, int, T *); \
+    template void statistical::sum(const T *, int, T *); \
+    template void statistical::normInf(const T *, int, T *); \
+    template void statistical::normL1(const T *, int, T *); \
+    template void statistical::normL2(const T *, int, T *); \
+    template void statistical::minMax(const T *, int, T *, T *); \
+    template void statistical::minIndx(const T *, int, T *, int *); \
+    template void statistical::maxIndx(const T *, int, T *, int *); \
+    template void statistical::minMaxIndx(const T *, int, T *, int *, T *, int *); \
+    template void statistical::meanStdDev(const T *, int, T *, T *); \
+    template void statistical::dotProd(const T *, const T *, int, T *); \
+    template void statistical::normDiffInf(const T *, const T *, int, T *); \
+    template void statistical::normDiffL1(const T *, const T *, int, T *); \
+    template void statistical::normDiffL2(const T *, const T *, int, T *)
+
+OCL_INSTANTIATE_STATISTICAL_HOST(int8_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(uint8_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(int16_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(uint16_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(int32_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(uint32_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(int64_t);
+OCL_INSTANTIATE_STATISTICAL_HOST(uint64_t);
+
+#define OCL_INSTANTIATE_STATISTICAL_DEVICE(T) \
+    template void statistical::min(const DeviceArray<T>&, T *); \
+    template void statistical::max(const DeviceArray<T>&, T *); \
+    template void statistical::minMax(const DeviceArray<T>&, T *, T *); \
+    template void statistical::minIndx(const DeviceArray<T>&, T *, int *); \
+    template void statistical::maxIndx(const DeviceArray<T>&, T *, int *); \
+    template void statistical::minMaxIndx(const DeviceArray<T>&, T *, int *, T *, int *); \
+    template void statistical::sum(const DeviceArray<T>&, T *); \
+    template void statistical::meanStdDev(const DeviceArray<T>&, T *, T *); \
+    template void statistical::dotProd(const DeviceArray<T>&, const DeviceArray<T>&, T *); \
+    template void statistical::normInf(const DeviceArray<T>&, T *); \
+    template void statistical::normL1(const DeviceArray<T>&, T *); \
+    template void statistical::normL2(const DeviceArray<T>&, T *); \
+    template void statistical::normDiffInf(const DeviceArray<T>&, const DeviceArray<T>&, T *); \
+    template void statistical::normDiffL1(const DeviceArray<T>&, const DeviceArray<T>&, T *); \
+    template void statistical::normDiffL2(const DeviceArray<T>&, const DeviceArray<T>&, T *)
+
+OCL_INSTANTIATE_STATISTICAL_DEVICE(float);
+OCL_INSTANTIATE_STATISTICAL_DEVICE(double);
+
+namespace power
+{
+    _SIMD_OCL_T void inv(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::SubCRev<int32_t>>(pSrc, val, pDst, len);
+        nosimd::power::inv(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
-    {
-        internals::execKernel<internals::Kernel::DivCRev<int32_t>>(pSrc, val, pDst, len);
-    }
+    _SIMD_OCL_SPEC void inv(const float * pSrc, float * pDst, int len) { f24::inv(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void inv(const double * pSrc, double * pDst, int len) { d53::inv(pSrc, pDst, len); }
 
-    _SIMD_OCL_SPEC void add(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    _SIMD_OCL_T void sqrt(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Add<int32_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::power::sqrt(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void sub(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    _SIMD_OCL_SPEC void sqrt(const float * pSrc, float * pDst, int len) { f24::sqrt(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void sqrt(const double * pSrc, double * pDst, int len) { d53::sqrt(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void invSqrt(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Sub<int32_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::power::invSqrt(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void mul(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    _SIMD_OCL_SPEC void invSqrt(const float * pSrc, float * pDst, int len) { f24::invSqrt(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void invSqrt(const double * pSrc, double * pDst, int len) { d53::invSqrt(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void cbrt(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Mul<int32_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::power::cbrt(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void div(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
+    _SIMD_OCL_SPEC void cbrt(const float * pSrc, float * pDst, int len) { f24::cbrt(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void cbrt(const double * pSrc, double * pDst, int len) { d53::cbrt(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void powx(const _T * pSrc, const _T constValue, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Div<int32_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::power::powx(pSrc, constValue, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void abs(const int32_t * pSrc, int32_t * pDst, int len)
+    _SIMD_OCL_SPEC void powx(const float * pSrc, const float constValue, float * pDst, int len) { f24::powx(pSrc, constValue, pDst, len); }
+    _SIMD_OCL_SPEC void powx(const double * pSrc, const double constValue, double * pDst, int len) { d53::powx(pSrc, constValue, pDst, len); }
+
+    _SIMD_OCL_T void pow(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Abs<int32_t>>(pSrc, 0, pDst, len);
+        nosimd::power::pow(pSrc1, pSrc2, pDst, len);
     }
 
-    // uint32_t
+    _SIMD_OCL_SPEC void pow(const float * pSrc1, const float * pSrc2, float * pDst, int len) { f24::pow(pSrc1, pSrc2, pDst, len); }
+    _SIMD_OCL_SPEC void pow(const double * pSrc1, const double * pSrc2, double * pDst, int len) { d53::pow(pSrc1, pSrc2, pDst, len); }
 
-    _SIMD_OCL_SPEC void addC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    _SIMD_OCL_T void hypot(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::AddC<uint32_t>>(pSrc, val, pDst, len);
+        nosimd::power::hypot(pSrc1, pSrc2, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void subC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    _SIMD_OCL_SPEC void hypot(const float * pSrc1, const float * pSrc2, float * pDst, int len) { f24::hypot(pSrc1, pSrc2, pDst, len); }
+    _SIMD_OCL_SPEC void hypot(const double * pSrc1, const double * pSrc2, double * pDst, int len) { d53::hypot(pSrc1, pSrc2, pDst, len); }
+
+    namespace f21
     {
-        internals::execKernel<internals::Kernel::SubC<uint32_t>>(pSrc, val, pDst, len);
+        void inv(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Inv, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void sqrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Sqrt, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void invSqrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::InvSqrt, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void cbrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Cbrt, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void powx(const float * pSrc, const float constValue, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Powx, internals::Kernel::Precision::Native>>(pSrc, constValue, pDst, len);
+        }
+
+        void pow(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Pow, internals::Kernel::Precision::Native>>(pSrc1, pSrc2, pDst, len);
+        }
+
+        void hypot(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Hypot, internals::Kernel::Precision::Native>>(pSrc1, pSrc2, pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void mulC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    namespace f24
     {
-        internals::execKernel<internals::Kernel::MulC<uint32_t>>(pSrc, val, pDst, len);
+        void inv(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Inv, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void sqrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Sqrt, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void invSqrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::InvSqrt, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void cbrt(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Cbrt, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void powx(const float * pSrc, const float constValue, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Powx, internals::Kernel::Precision::Accurate>>(pSrc, constValue, pDst, len);
+        }
+
+        void pow(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Pow, internals::Kernel::Precision::Accurate>>(pSrc1, pSrc2, pDst, len);
+        }
+
+        void hypot(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Hypot, internals::Kernel::Precision::Accurate>>(pSrc1, pSrc2, pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void divC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    namespace d50
     {
-        internals::execKernel<internals::Kernel::DivC<uint32_t>>(pSrc, val, pDst, len);
+        void inv(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Inv, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void sqrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Sqrt, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void invSqrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::InvSqrt, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void cbrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Cbrt, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void powx(const double * pSrc, const double constValue, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Powx, internals::Kernel::Precision::Relaxed>>(pSrc, constValue, pDst, len);
+        }
+
+        void pow(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Pow, internals::Kernel::Precision::Relaxed>>(pSrc1, pSrc2, pDst, len);
+        }
+
+        void hypot(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Hypot, internals::Kernel::Precision::Relaxed>>(pSrc1, pSrc2, pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void subCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+    namespace d53
     {
-        internals::execKernel<internals::Kernel::SubCRev<uint32_t>>(pSrc, val, pDst, len);
+        void inv(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Inv, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void sqrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Sqrt, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void invSqrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::InvSqrt, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void cbrt(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Cbrt, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void powx(const double * pSrc, const double constValue, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Powx, internals::Kernel::Precision::Accurate>>(pSrc, constValue, pDst, len);
+        }
+
+        void pow(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Pow, internals::Kernel::Precision::Accurate>>(pSrc1, pSrc2, pDst, len);
+        }
+
+        void hypot(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Hypot, internals::Kernel::Precision::Accurate>>(pSrc1, pSrc2, pDst, len);
+        }
     }
+}
 
-    _SIMD_OCL_SPEC void divCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
+namespace exp_log
+{
+    _SIMD_OCL_T void exp(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::DivCRev<uint32_t>>(pSrc, val, pDst, len);
+        nosimd::exp_log::exp(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void add(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    _SIMD_OCL_SPEC void exp(const float * pSrc, float * pDst, int len) { f24::exp(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void exp(const double * pSrc, double * pDst, int len) { d53::exp(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void ln(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::Add<uint32_t>>(pSrc1, pSrc2, pDst, len);
+        nosimd::exp_log::ln(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void sub(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    _SIMD_OCL_SPEC void ln(const float * pSrc, float * pDst, int len) { f24::ln(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void ln(const double * pSrc, double * pDst, int len) { d53::ln(pSrc, pDst, len); }
+
+    namespace f21
     {
-        internals::execKernel<internals::Kernel::Sub<uint32_t>>(pSrc1, pSrc2, pDst, len);
+        void exp(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Exp, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void ln(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Ln, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void mul(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    namespace f24
     {
-        internals::execKernel<internals::Kernel::Mul<uint32_t>>(pSrc1, pSrc2, pDst, len);
+        void exp(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Exp, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void ln(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Ln, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void div(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
+    namespace d50
     {
-        internals::execKernel<internals::Kernel::Div<uint32_t>>(pSrc1, pSrc2, pDst, len);
+        void exp(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Exp, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void ln(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Ln, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void abs(const uint32_t * pSrc, uint32_t * pDst, int len)
+    namespace d53
     {
-        if (pSrc != pDst)
-            copy(pSrc, pDst, len);
-    }
+        void exp(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Exp, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
 
-    // int64_t
+        void ln(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Ln, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+    }
+}
 
-    _SIMD_OCL_SPEC void addC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+namespace trigonometric
+{
+    _SIMD_OCL_T void sin(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::AddC<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::sin(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void subC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void sin(const float * pSrc, float * pDst, int len) { f24::sin(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void sin(const double * pSrc, double * pDst, int len) { d53::sin(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void cos(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::SubC<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::cos(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void mulC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void cos(const float * pSrc, float * pDst, int len) { f24::cos(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void cos(const double * pSrc, double * pDst, int len) { d53::cos(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void tan(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::MulC<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::tan(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void divC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void tan(const float * pSrc, float * pDst, int len) { f24::tan(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void tan(const double * pSrc, double * pDst, int len) { d53::tan(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void asin(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::DivC<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::asin(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void asin(const float * pSrc, float * pDst, int len) { f24::asin(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void asin(const double * pSrc, double * pDst, int len) { d53::asin(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void acos(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::SubCRev<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::acos(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void acos(const float * pSrc, float * pDst, int len) { f24::acos(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void acos(const double * pSrc, double * pDst, int len) { d53::acos(pSrc, pDst, len); }
+
+    _SIMD_OCL_T void atan(const _T * pSrc, _T * pDst, int len)
     {
-        internals::execKernel<internals::Kernel::DivCRev<int64_t>>(pSrc, val, pDst, len);
+        nosimd::trigonometric::atan(pSrc, pDst, len);
     }
 
-    _SIMD_OCL_SPEC void add(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    _SIMD_OCL_SPEC void atan(const float * pSrc, float * pDst, int len) { f24::atan(pSrc, pDst, len); }
+    _SIMD_OCL_SPEC void atan(const double * pSrc, double * pDst, int len) { d53::atan(pSrc, pDst, len); }
+
+    namespace f21
     {
-        internals::execKernel<internals::Kernel::Add<int64_t>>(pSrc1, pSrc2, pDst, len);
+        void sin(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Sin, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void cos(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Cos, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void tan(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Tan, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void asin(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Asin, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void acos(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Acos, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
+
+        void atan(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Atan, internals::Kernel::Precision::Native>>(pSrc, float(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void sub(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    namespace f24
     {
-        internals::execKernel<internals::Kernel::Sub<int64_t>>(pSrc1, pSrc2, pDst, len);
+        void sin(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Sin, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void cos(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Cos, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void tan(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Tan, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void asin(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Asin, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void acos(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Acos, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
+
+        void atan(const float * pSrc, float * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<float, internals::Kernel::MathOp::Atan, internals::Kernel::Precision::Accurate>>(pSrc, float(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void mul(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    namespace d50
     {
-        internals::execKernel<internals::Kernel::Mul<int64_t>>(pSrc1, pSrc2, pDst, len);
+        void sin(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Sin, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void cos(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Cos, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void tan(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Tan, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void asin(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Asin, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void acos(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Acos, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
+
+        void atan(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Atan, internals::Kernel::Precision::Relaxed>>(pSrc, double(0), pDst, len);
+        }
     }
 
-    _SIMD_OCL_SPEC void div(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
+    namespace d53
     {
-        internals::execKernel<internals::Kernel::Div<int64_t>>(pSrc1, pSrc2, pDst, len);
+        void sin(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Sin, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void cos(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Cos, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void tan(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Tan, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void asin(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Asin, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void acos(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Acos, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
+
+        void atan(const double * pSrc, double * pDst, int len)
+        {
+            internals::execKernel<internals::Kernel::Math<double, internals::Kernel::MathOp::Atan, internals::Kernel::Precision::Accurate>>(pSrc, double(0), pDst, len);
+        }
     }
+}
 
-    _SIMD_OCL_SPEC void abs(const int64_t * pSrc, int64_t * pDst, int len)
-    {
-        internals::execKernel<internals::Kernel::Abs<int64_t>>(pSrc, 0l, pDst, len);
+#define OCL_INSTANTIATE_MATH_HOST(T) \
+    template void power::inv(const T *, T *, int); \
+    template void power::sqrt(const T *, T *, int); \
+    template void power::invSqrt(const T *, T *, int); \
+    template void power::cbrt(const T *, T *, int); \
+    template void power::powx(const T *, const T, T *, int); \
+    template void power::pow(const T *, const T *, T *, int); \
+    template void power::hypot(const T *, const T *, T *, int); \
+    template void exp_log::exp(const T *, T *, int); \
+    template void exp_log::ln(const T *, T *, int); \
+    template void trigonometric::sin(const T *, T *, int); \
+    template void trigonometric::cos(const T *, T *, int); \
+    template void trigonometric::tan(const T *, T *, int); \
+    template void trigonometric::asin(const T *, T *, int); \
+    template void trigonometric::acos(const T *, T *, int); \
+    template void trigonometric::atan(const T *, T *, int)
+
+OCL_INSTANTIATE_MATH_HOST(int8_t);
+OCL_INSTANTIATE_MATH_HOST(uint8_t);
+OCL_INSTANTIATE_MATH_HOST(int16_t);
+OCL_INSTANTIATE_MATH_HOST(uint16_t);
+OCL_INSTANTIATE_MATH_HOST(int32_t);
+OCL_INSTANTIATE_MATH_HOST(uint32_t);
+OCL_INSTANTIATE_MATH_HOST(int64_t);
+OCL_INSTANTIATE_MATH_HOST(uint64_t);
+
+// DeviceSelector, Context
+
+DeviceSelector DeviceSelector::parse(const std::string& spec)
+{
+    DeviceSelector sel;
+    bool platformSet = false;
+    size_t pos = 0;
+    while (pos <= spec.size())
+    {
+        size_t end = spec.find(':', pos);
+        if (end == std::string::npos)
+            end = spec.size();
+        std::string field = spec.substr(pos, end - pos);
+        pos = end + 1;
+
+        if (field.empty() || field == "any")
+            continue;
+        if (field == "gpu")
+            sel.type = Type::Gpu;
+        else if (field == "accelerator")
+            sel.type = Type::Accelerator;
+        else if (field == "cpu")
+            sel.type = Type::Cpu;
+        else if (field.find_first_not_of("0123456789") == std::string::npos)
+        {
+            if (!platformSet)
+                sel.platformIndex = std::stoi(field);
+            else
+                sel.deviceIndex = std::stoi(field);
+            platformSet = true;
+        }
+        else
+            sel.vendor = field;
     }
+    return sel;
+}
 
-    // uint64_t
+DeviceSelector DeviceSelector::fromEnvironment()
+{
+    const char * spec = getenv("SIMD_OCL_DEVICE");
+    return spec ? parse(spec) : DeviceSelector();
+}
 
-    _SIMD_OCL_SPEC void addC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+Context::Context(const DeviceSelector& selector)
+:   impl_(internals::SimdOpenCl::create(selector))
+{}
+
+std::string Context::deviceName() const
+{
+    return impl_->deviceName();
+}
+
+Context defaultContext()
+{
+    return Context(internals::SimdOpenCl::defaultInstance());
+}
+
+ContextScope::ContextScope(const Context& ctx)
+:   ctx_(ctx),
+    prev_(internals::SimdOpenCl::current())
+{
+    internals::SimdOpenCl::current() = &ctx_.impl();
+}
+
+ContextScope::~ContextScope()
+{
+    internals::SimdOpenCl::current() = prev_;
+}
+
+// DeviceGroup
+
+DeviceGroup::DeviceGroup(const DeviceSelector& selector)
+{
+    std::vector<Context> contexts;
+    for (const internals::DeviceFinder::Found& found : internals::DeviceFinder::findAll(selector))
+        contexts.push_back(Context(internals::SimdOpenCl::create(found)));
+    state_ = std::make_shared<internals::GroupState>(contexts);
+}
+
+DeviceGroup::DeviceGroup(const std::vector<Context>& contexts)
+:   state_(std::make_shared<internals::GroupState>(contexts))
+{}
+
+const std::vector<Context>& DeviceGroup::contexts() const { return state_->contexts(); }
+std::vector<double> DeviceGroup::weights() const { return state_->weights(); }
+void DeviceGroup::setWeights(const std::vector<double>& weights) { state_->setWeights(weights); }
+void DeviceGroup::calibrate() { state_->calibrate(); }
+int DeviceGroup::minLength() const { return state_->minLength; }
+void DeviceGroup::setMinLength(int len) { state_->minLength = std::max(len, 0); }
+std::vector<int> DeviceGroup::split(int len) const { return state_->split(len); }
+
+DeviceGroupScope::DeviceGroupScope(const DeviceGroup& group)
+:   group_(group),
+    prev_(internals::GroupState::current())
+{
+    internals::GroupState::current() = group_.state_.get();
+}
+
+DeviceGroupScope::~DeviceGroupScope()
+{
+    internals::GroupState::current() = prev_;
+}
+
+void setPipelineOptions(const PipelineOptions& opts)
+{
+    PipelineOptions& cur = internals::pipelineOpts();
+    cur.minLength = std::max(opts.minLength, 0);
+    cur.chunkLength = internals::alignedSize(std::max(opts.chunkLength, 1));
+    cur.queues = std::max(opts.queues, 1);
+}
+
+PipelineOptions pipelineOptions()
+{
+    return internals::pipelineOpts();
+}
+
+TransferCost measureTransferCost()
+{
+    // best of a few runs: the first call also builds the float program.
+    // Host arrays are padded to the work size like every array reaching exec: it moves the padding too.
+    auto bestTime = [](int len, int runs)
+    {
+        std::shared_ptr<float> a(common::malloc<float>(len), common::free<float>);
+        std::shared_ptr<float> b(common::malloc<float>(len), common::free<float>);
+        std::shared_ptr<float> c(common::malloc<float>(len), common::free<float>);
+        std::fill(a.get(), a.get() + len, 1.f);
+        std::fill(b.get(), b.get() + len, 2.f);
+
+        double best = 1e30;
+        for (int i = 0; i < runs; ++i)
+        {
+            auto start = std::chrono::steady_clock::now();
+            arithmetic::add(a.get(), b.get(), c.get(), len);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        return best;
+    };
+
+    static constexpr int bigLength = 1 << 22;
+    TransferCost cost;
+    cost.latency = bestTime(1, 8);
+    double big = bestTime(bigLength, 3);
+    cost.bytesPerSecond = 3. * bigLength * sizeof(float) / std::max(big - cost.latency, 1e-9);
+    return cost;
+}
+
+// Event
+
+void Event::wait() const
+{
+    if (state_)
+        state_->wait();
+}
+
+bool Event::ready() const
+{
+    return !state_ || state_->ready();
+}
+
+namespace async
+{
+    _SIMD_OCL_T Event addC(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::AddC<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::AddC<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void subC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event subC(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::SubC<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::SubC<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void mulC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event mulC(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::MulC<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::MulC<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void divC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event divC(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::DivC<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::DivC<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event subCRev(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::SubCRev<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::SubCRev<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event divCRev(const _T * pSrc, _T val, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::DivCRev<uint64_t>>(pSrc, val, pDst, len);
+        return internals::execAsync<internals::Kernel::DivCRev<_T>>(pSrc, val, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void add(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event add(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::Add<uint64_t>>(pSrc1, pSrc2, pDst, len);
+        return internals::execAsync<internals::Kernel::Add<_T>>(pSrc1, pSrc2, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void sub(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event sub(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::Sub<uint64_t>>(pSrc1, pSrc2, pDst, len);
+        return internals::execAsync<internals::Kernel::Sub<_T>>(pSrc1, pSrc2, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void mul(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event mul(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::Mul<uint64_t>>(pSrc1, pSrc2, pDst, len);
+        return internals::execAsync<internals::Kernel::Mul<_T>>(pSrc1, pSrc2, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void div(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event div(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::Div<uint64_t>>(pSrc1, pSrc2, pDst, len);
+        return internals::execAsync<internals::Kernel::Div<_T>>(pSrc1, pSrc2, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void abs(const uint64_t * pSrc, uint64_t * pDst, int len)
+    _SIMD_OCL_T Event abs(const _T * pSrc, _T * pDst, int len, const EventList& waitFor)
     {
-        if (pSrc != pDst)
-            copy(pSrc, pDst, len);
+        return internals::execAsync<internals::Kernel::Abs<_T>>(pSrc, _T(0), pDst, len, waitFor);
     }
 
-    // float
+    // unsigned abs is a host copy: it completes before returning
 
-    _SIMD_OCL_SPEC void addC(const float * pSrc, float val, float * pDst, int len)
+    template <typename _T>
+    static Event copyNow(const _T * pSrc, _T * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::AddC<float>>(pSrc, val, pDst, len);
+        for (auto& ev : waitFor)
+            ev.wait();
+        if (pSrc != pDst)
+            copy(pSrc, pDst, len);
+        return Event();
     }
 
-    _SIMD_OCL_SPEC void subC(const float * pSrc, float val, float * pDst, int len)
+    _SIMD_OCL_SPEC Event abs(const uint8_t * pSrc, uint8_t * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::SubC<float>>(pSrc, val, pDst, len);
+        return copyNow(pSrc, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void mulC(const float * pSrc, float val, float * pDst, int len)
+    _SIMD_OCL_SPEC Event abs(const uint16_t * pSrc, uint16_t * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::MulC<float>>(pSrc, val, pDst, len);
+        return copyNow(pSrc, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void divC(const float * pSrc, float val, float * pDst, int len)
+    _SIMD_OCL_SPEC Event abs(const uint32_t * pSrc, uint32_t * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::DivC<float>>(pSrc, val, pDst, len);
+        return copyNow(pSrc, pDst, len, waitFor);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const float * pSrc, float val, float * pDst, int len)
+    _SIMD_OCL_SPEC Event abs(const uint64_t * pSrc, uint64_t * pDst, int len, const EventList& waitFor)
     {
-        internals::execKernel<internals::Kernel::SubCRev<float>>(pSrc, val, pDst, len);
+        return copyNow(pSrc, pDst, len, waitFor);
     }
+}
 
-    _SIMD_OCL_SPEC void divCRev(const float * pSrc, float val, float * pDst, int len)
-    {
-        internals::execKernel<internals::Kernel::DivCRev<float>>(pSrc, val, pDst, len);
-    }
+#define OCL_INSTANTIATE_ASYNC(T) \
+    template Event async::addC(const T *, T, T *, int, const EventList&); \
+    template Event async::subC(const T *, T, T *, int, const EventList&); \
+    template Event async::mulC(const T *, T, T *, int, const EventList&); \
+    template Event async::divC(const T *, T, T *, int, const EventList&); \
+    template Event async::subCRev(const T *, T, T *, int, const EventList&); \
+    template Event async::divCRev(const T *, T, T *, int, const EventList&); \
+    template Event async::add(const T *, const T *, T *, int, const EventList&); \
+    template Event async::sub(const T *, const T *, T *, int, const EventList&); \
+    template Event async::mul(const T *, const T *, T *, int, const EventList&); \
+    template Event async::div(const T *, const T *, T *, int, const EventList&)
+
+OCL_INSTANTIATE_ASYNC(int8_t);
+OCL_INSTANTIATE_ASYNC(uint8_t);
+OCL_INSTANTIATE_ASYNC(int16_t);
+OCL_INSTANTIATE_ASYNC(uint16_t);
+OCL_INSTANTIATE_ASYNC(int32_t);
+OCL_INSTANTIATE_ASYNC(uint32_t);
+OCL_INSTANTIATE_ASYNC(int64_t);
+OCL_INSTANTIATE_ASYNC(uint64_t);
+OCL_INSTANTIATE_ASYNC(float);
+OCL_INSTANTIATE_ASYNC(double);
+
+template Event async::abs(const int8_t *, int8_t *, int, const EventList&);
+template Event async::abs(const int16_t *, int16_t *, int, const EventList&);
+template Event async::abs(const int32_t *, int32_t *, int, const EventList&);
+template Event async::abs(const int64_t *, int64_t *, int, const EventList&);
+template Event async::abs(const float *, float *, int, const EventList&);
+template Event async::abs(const double *, double *, int, const EventList&);
+
+// DeviceArray
+
+_SIMD_OCL_T DeviceArray<_T>::DeviceArray(int len)
+{
+    resize(len);
+}
 
-    _SIMD_OCL_SPEC void add(const float * pSrc1, const float * pSrc2, float * pDst, int len)
-    {
-        internals::execKernel<internals::Kernel::Add<float>>(pSrc1, pSrc2, pDst, len);
-    }
+_SIMD_OCL_T DeviceArray<_T>::DeviceArray(const _T* pSrc, int len)
+{
+    upload(pSrc, len);
+}
 
-    _SIMD_OCL_SPEC void sub(const float * pSrc1, const float * pSrc2, float * pDst, int len)
-    {
-        internals::execKernel<internals::Kernel::Sub<float>>(pSrc1, pSrc2, pDst, len);
-    }
+_SIMD_OCL_T void DeviceArray<_T>::resize(int len)
+{
+    if (len == len_ && buffer_)
+        return;
 
-    _SIMD_OCL_SPEC void mul(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+    // stays in its context once allocated
+    internals::SimdOpenCl& ctx = buffer_ ? buffer_->owner() : internals::SimdOpenCl::getInstance();
+    buffer_ = ctx.allocDevice(len * sizeof(_T));
+    len_ = len;
+}
+
+_SIMD_OCL_T void DeviceArray<_T>::upload(const _T* pSrc, int len)
+{
+    resize(len);
+    if (len)
+        buffer_->owner().syncWriteToGPU(pSrc, buffer_->dataSize(), buffer_->mem());
+}
+
+_SIMD_OCL_T void DeviceArray<_T>::download(_T* pDst) const
+{
+    if (len_)
+        buffer_->owner().syncReadFromGPU(pDst, buffer_->dataSize(), buffer_->mem());
+}
+
+namespace common
+{
+    _SIMD_OCL_T void copy(const DeviceArray<_T>& src, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Mul<float>>(pSrc1, pSrc2, pDst, len);
+        if (src.empty() || src.buffer() == dst.buffer())
+            return;
+
+        internals::prepareDst(src, dst);
+        src.buffer()->owner().copyOnGPU(
+            src.buffer()->mem(), dst.buffer()->mem(), src.buffer()->dataSize());
     }
+}
 
-    _SIMD_OCL_SPEC void div(const float * pSrc1, const float * pSrc2, float * pDst, int len)
+namespace arithmetic
+{
+    _SIMD_OCL_T void addC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Div<float>>(pSrc1, pSrc2, pDst, len);
+        internals::execKernel<internals::Kernel::AddC<_T>>(src, val, dst);
     }
 
-    _SIMD_OCL_SPEC void abs(const float * pSrc, float * pDst, int len)
+    _SIMD_OCL_T void subC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Abs<float>>(pSrc, 0.0f, pDst, len);
+        internals::execKernel<internals::Kernel::SubC<_T>>(src, val, dst);
     }
 
-    // double
-
-    _SIMD_OCL_SPEC void addC(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void mulC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::AddC<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::MulC<_T>>(src, val, dst);
     }
 
-    _SIMD_OCL_SPEC void subC(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void divC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::SubC<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::DivC<_T>>(src, val, dst);
     }
 
-    _SIMD_OCL_SPEC void mulC(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void subCRev(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::MulC<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::SubCRev<_T>>(src, val, dst);
     }
 
-    _SIMD_OCL_SPEC void divC(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void divCRev(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::DivC<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::DivCRev<_T>>(src, val, dst);
     }
 
-    _SIMD_OCL_SPEC void subCRev(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void add(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::SubCRev<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::Add<_T>>(src1, src2, dst);
     }
 
-    _SIMD_OCL_SPEC void divCRev(const double * pSrc, double val, double * pDst, int len)
+    _SIMD_OCL_T void sub(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::DivCRev<double>>(pSrc, val, pDst, len);
+        internals::execKernel<internals::Kernel::Sub<_T>>(src1, src2, dst);
     }
 
-    _SIMD_OCL_SPEC void add(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    _SIMD_OCL_T void mul(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Add<double>>(pSrc1, pSrc2, pDst, len);
+        internals::execKernel<internals::Kernel::Mul<_T>>(src1, src2, dst);
     }
 
-    _SIMD_OCL_SPEC void sub(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    _SIMD_OCL_T void div(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Sub<double>>(pSrc1, pSrc2, pDst, len);
+        internals::execKernel<internals::Kernel::Div<_T>>(src1, src2, dst);
     }
 
-    _SIMD_OCL_SPEC void mul(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    _SIMD_OCL_T void abs(const DeviceArray<_T>& src, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Mul<double>>(pSrc1, pSrc2, pDst, len);
+        internals::execKernel<internals::Kernel::Abs<_T>>(src, _T(0), dst);
     }
 
-    _SIMD_OCL_SPEC void div(const double * pSrc1, const double * pSrc2, double * pDst, int len)
+    // unsigned abs is a copy
+
+    _SIMD_OCL_SPEC void abs(const DeviceArray<uint8_t>& src, DeviceArray<uint8_t>& dst) { copy(src, dst); }
+    _SIMD_OCL_SPEC void abs(const DeviceArray<uint16_t>& src, DeviceArray<uint16_t>& dst) { copy(src, dst); }
+    _SIMD_OCL_SPEC void abs(const DeviceArray<uint32_t>& src, DeviceArray<uint32_t>& dst) { copy(src, dst); }
+    _SIMD_OCL_SPEC void abs(const DeviceArray<uint64_t>& src, DeviceArray<uint64_t>& dst) { copy(src, dst); }
+}
+
+#define OCL_INSTANTIATE_DEVICE_ARRAY(T) \
+    template class DeviceArray<T>; \
+    template void common::copy(const DeviceArray<T>&, DeviceArray<T>&); \
+    template void arithmetic::addC(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::subC(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::mulC(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::divC(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::subCRev(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::divCRev(const DeviceArray<T>&, T, DeviceArray<T>&); \
+    template void arithmetic::add(const DeviceArray<T>&, const DeviceArray<T>&, DeviceArray<T>&); \
+    template void arithmetic::sub(const DeviceArray<T>&, const DeviceArray<T>&, DeviceArray<T>&); \
+    template void arithmetic::mul(const DeviceArray<T>&, const DeviceArray<T>&, DeviceArray<T>&); \
+    template void arithmetic::div(const DeviceArray<T>&, const DeviceArray<T>&, DeviceArray<T>&)
+
+OCL_INSTANTIATE_DEVICE_ARRAY(int8_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(uint8_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(int16_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(uint16_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(int32_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(uint32_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(int64_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(uint64_t);
+OCL_INSTANTIATE_DEVICE_ARRAY(float);
+OCL_INSTANTIATE_DEVICE_ARRAY(double);
+
+template void arithmetic::abs(const DeviceArray<int8_t>&, DeviceArray<int8_t>&);
+template void arithmetic::abs(const DeviceArray<int16_t>&, DeviceArray<int16_t>&);
+template void arithmetic::abs(const DeviceArray<int32_t>&, DeviceArray<int32_t>&);
+template void arithmetic::abs(const DeviceArray<int64_t>&, DeviceArray<int64_t>&);
+template void arithmetic::abs(const DeviceArray<float>&, DeviceArray<float>&);
+template void arithmetic::abs(const DeviceArray<double>&, DeviceArray<double>&);
+
+namespace fused
+{
+    _SIMD_OCL_T void evaluate(const Expr<_T>& expr, DeviceArray<_T>& dst)
     {
-        internals::execKernel<internals::Kernel::Div<double>>(pSrc1, pSrc2, pDst, len);
+        internals::FusedKernel<_T> kernel(*expr.node());
+        const std::vector<const DeviceArray<_T>*>& inputs = kernel.inputs();
+        if (inputs.empty())
+            throw OCL_EXCEPT(CL_INVALID_VALUE, "fused expression without DeviceArray");
+
+        const DeviceArray<_T>& first = *inputs[0];
+        std::vector<cl_mem> mems;
+        for (const DeviceArray<_T>* src : inputs)
+        {
+            if (src->size() != first.size())
+                throw OCL_EXCEPT(CL_INVALID_VALUE, "DeviceArray size mismatch");
+            if (src->empty())
+                return;
+            if (&src->buffer()->owner() != &first.buffer()->owner())
+                throw OCL_EXCEPT(CL_INVALID_CONTEXT, "DeviceArrays from different contexts");
+            mems.push_back(src->buffer()->mem());
+        }
+
+        internals::prepareDst(first, dst);
+        first.buffer()->owner().execFused(kernel.text(), mems, kernel.scalars(), dst.buffer()->mem(), first.size());
     }
 
-    _SIMD_OCL_SPEC void abs(const double * pSrc, double * pDst, int len)
+    size_t kernelCount(const Context& ctx)
     {
-        internals::execKernel<internals::Kernel::Abs<double>>(pSrc, 0.0, pDst, len);
+        return ctx.impl().fusedCount();
     }
 }
 
+template void fused::evaluate(const fused::Expr<int8_t>&, DeviceArray<int8_t>&);
+template void fused::evaluate(const fused::Expr<uint8_t>&, DeviceArray<uint8_t>&);
+template void fused::evaluate(const fused::Expr<int16_t>&, DeviceArray<int16_t>&);
+template void fused::evaluate(const fused::Expr<uint16_t>&, DeviceArray<uint16_t>&);
+template void fused::evaluate(const fused::Expr<int32_t>&, DeviceArray<int32_t>&);
+template void fused::evaluate(const fused::Expr<uint32_t>&, DeviceArray<uint32_t>&);
+template void fused::evaluate(const fused::Expr<int64_t>&, DeviceArray<int64_t>&);
+template void fused::evaluate(const fused::Expr<uint64_t>&, DeviceArray<uint64_t>&);
+template void fused::evaluate(const fused::Expr<float>&, DeviceArray<float>&);
+template void fused::evaluate(const fused::Expr<double>&, DeviceArray<double>&);
+
 } // ocl
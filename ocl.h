@@ -1,4 +1,9 @@
 #pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include <type_traits>
+
 #include "nosimd.h"
 
 #ifndef _SIMD_OCL_T
@@ -11,18 +16,199 @@ namespace ocl
     namespace internals
     {
         int alignedSize(int len);
+        void * hostAlloc(size_t dataSize);
+        void hostFree(void * ptr);
+
+        class DeviceBuffer;
+        class EventState;
+        class GroupState;
+        class SimdOpenCl;
     }
 
+    /// Which device a Context drives. Fields left at their defaults match anything;
+    /// among the matching devices a GPU is preferred to an accelerator, an accelerator to a CPU.
+    struct DeviceSelector
+    {
+        enum class Type
+        {
+            Any,
+            Gpu,
+            Accelerator,
+            Cpu
+        };
+
+        Type type = Type::Any;
+        std::string vendor;     // case-insensitive substring of the platform or device name/vendor
+        int platformIndex = -1;
+        int deviceIndex = -1;   // index among all devices of the platform
+
+        /// ':'-separated fields: "gpu", "accelerator", "cpu" or "any" set the type, the first number
+        /// is the platform index, the second the device index, anything else is a vendor.
+        /// e.g. "cpu", "nvidia", "1:0", "cpu:pocl"
+        static DeviceSelector parse(const std::string& spec);
+
+        /// $SIMD_OCL_DEVICE, or any device if it is not set
+        static DeviceSelector fromEnvironment();
+    };
+
+    /// An OpenCL device with its own context, command queues, buffer pool and kernels.
+    /// Copies share the same device state.
+    class Context
+    {
+    public:
+        explicit Context(const DeviceSelector& selector = DeviceSelector::fromEnvironment());
+        explicit Context(std::shared_ptr<internals::SimdOpenCl> impl)
+        :   impl_(impl)
+        {}
+
+        std::string deviceName() const;
+        internals::SimdOpenCl& impl() const { return *impl_; }
+
+    private:
+        std::shared_ptr<internals::SimdOpenCl> impl_;
+    };
+
+    /// Context used when no ContextScope is active, selected by $SIMD_OCL_DEVICE on first use
+    Context defaultContext();
+
+    /// Routes this thread's operations to ctx while alive. Scopes nest.
+    class ContextScope
+    {
+    public:
+        explicit ContextScope(const Context& ctx);
+        ~ContextScope();
+
+        ContextScope(const ContextScope&) = delete;
+        ContextScope& operator = (const ContextScope&) = delete;
+
+    private:
+        Context ctx_;
+        internals::SimdOpenCl * prev_;
+    };
+
+    /// Devices sharing the large host array calls. While a DeviceGroupScope is active, elementwise calls of at
+    /// least minLength() elements are cut into one contiguous slice per device, sized by the device weights.
+    /// Each device moves and computes its slice through its own queues and buffer pool and writes straight
+    /// into its part of pDst. Shorter calls run on the heaviest device. Copies share the same state.
+    class DeviceGroup
+    {
+    public:
+        /// Every device matching the selector, across all platforms
+        explicit DeviceGroup(const DeviceSelector& selector = DeviceSelector());
+        explicit DeviceGroup(const std::vector<Context>& contexts);
+
+        const std::vector<Context>& contexts() const;
+
+        /// Shares of the work, summing to 1. The first split measures them unless they were set.
+        std::vector<double> weights() const;
+        void setWeights(const std::vector<double>& weights);
+        void calibrate(); // weights from the throughput of every device on a large call, transfers included
+
+        int minLength() const;
+        void setMinLength(int len);
+
+        /// Elements per device for a call of len elements
+        std::vector<int> split(int len) const;
+
+    private:
+        std::shared_ptr<internals::GroupState> state_;
+
+        friend class DeviceGroupScope;
+    };
+
+    /// Splits this thread's host array calls over the group while alive. Scopes nest.
+    class DeviceGroupScope
+    {
+    public:
+        explicit DeviceGroupScope(const DeviceGroup& group);
+        ~DeviceGroupScope();
+
+        DeviceGroupScope(const DeviceGroupScope&) = delete;
+        DeviceGroupScope& operator = (const DeviceGroupScope&) = delete;
+
+    private:
+        DeviceGroup group_;
+        internals::GroupState * prev_;
+    };
+
+    /// Completion handle of an enqueued operation. Copies share the same state.
+    /// A default constructed Event is already complete.
+    class Event
+    {
+    public:
+        Event() = default;
+        explicit Event(std::shared_ptr<internals::EventState> state)
+        :   state_(state)
+        {}
+
+        void wait() const;  // throws simd::Exception if the operation failed
+        bool ready() const;
+
+        internals::EventState* state() const { return state_.get(); }
+
+    private:
+        std::shared_ptr<internals::EventState> state_;
+    };
+
+    using EventList = std::vector<Event>;
+
+    /// Inputs of at least minLength elements are split into chunks spread over several command queues,
+    /// so upload of one chunk overlaps compute and download of its neighbours.
+    struct PipelineOptions
+    {
+        int minLength = 1 << 22;    // shorter inputs go through a single write-kernel-read sequence
+        int chunkLength = 1 << 20;  // elements per chunk, rounded up to the work group size
+        int queues = 3;             // 1 disables pipelining
+    };
+
+    void setPipelineOptions(const PipelineOptions& opts);
+    PipelineOptions pipelineOptions();
+
+    /// Fixed and per-byte cost of a host array call on the current context, for CPU/device routing
+    struct TransferCost
+    {
+        double latency = 0;         // seconds for upload, launch and download of one element
+        double bytesPerSecond = 0;  // bytes crossing the bus per second in a large call, both directions
+    };
+
+    /// Times a few float additions. Throws simd::Exception without a usable device.
+    TransferCost measureTransferCost();
+
+    /// Array living in device memory. Data crosses the bus only on upload() and download().
+    /// Copies of a DeviceArray share the same device memory. The array stays bound to the context
+    /// that allocated it; operations on it run there.
+    _SIMD_OCL_T class DeviceArray
+    {
+    public:
+        DeviceArray() = default;
+        explicit DeviceArray(int len);
+        DeviceArray(const _T* pSrc, int len);
+
+        int size() const { return len_; }
+        bool empty() const { return len_ == 0; }
+
+        void resize(int len); // contents are undefined after reallocation
+        void upload(const _T* pSrc, int len);
+        void download(_T* pDst) const;
+
+        internals::DeviceBuffer* buffer() const { return buffer_.get(); }
+
+    private:
+        std::shared_ptr<internals::DeviceBuffer> buffer_;
+        int len_ = 0;
+    };
+
     namespace common
     {
+        // page aligned and padded to the work size: unified memory devices use it without copies
         _SIMD_OCL_T _T* malloc(int len)
         {
-            return new _T[internals::alignedSize(len)];
+            return static_cast<_T*>(internals::hostAlloc(internals::alignedSize(len) * sizeof(_T)));
         }
 
         _SIMD_OCL_T void free(_T* ptr)
         {
-            delete [] ptr;
+            internals::hostFree(ptr);
         }
 
         using nosimd::common::set;
@@ -30,6 +216,10 @@ namespace ocl
         using nosimd::common::zero;
         using nosimd::common::move;
         using nosimd::common::convert;
+        using nosimd::common::convertScale;
+        using nosimd::common::convertSfs;
+
+        _SIMD_OCL_T void copy(const DeviceArray<_T>& src, DeviceArray<_T>& dst);
     }
 
     namespace arithmetic
@@ -49,14 +239,400 @@ namespace ocl
         _SIMD_OCL_T void div(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len);
 
         _SIMD_OCL_T void abs(const _T* pSrc, _T* pDst, int len);
+
+        using nosimd::arithmetic::addSat;
+        using nosimd::arithmetic::subSat;
+        using nosimd::arithmetic::mulSat;
+        using nosimd::arithmetic::addSfs;
+        using nosimd::arithmetic::subSfs;
+        using nosimd::arithmetic::mulSfs;
+
+        // device-resident variants: no host transfers
+        _SIMD_OCL_T void addC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void add(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst);
+
+        _SIMD_OCL_T void subC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void subCRev(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void sub(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst);
+
+        _SIMD_OCL_T void mulC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void mul(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst);
+
+        _SIMD_OCL_T void divC(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void divCRev(const DeviceArray<_T>& src, _T val, DeviceArray<_T>& dst);
+        _SIMD_OCL_T void div(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, DeviceArray<_T>& dst);
+
+        _SIMD_OCL_T void abs(const DeviceArray<_T>& src, DeviceArray<_T>& dst);
+    }
+
+    /// float and double reduce on the device with a work-group tree reduction and only the scalar
+    /// crosses back to the host; other types reduce on the host.
+    namespace statistical
+    {
+        _SIMD_OCL_T void min(const _T* pSrc, int len, _T* pMin);
+        _SIMD_OCL_T void max(const _T* pSrc, int len, _T* pMax);
+        _SIMD_OCL_T void minMax(const _T* pSrc, int len, _T* pMin, _T* pMax);
+
+        _SIMD_OCL_T void minIndx(const _T* pSrc, int len, _T* pMin, int* pIndx);
+        _SIMD_OCL_T void maxIndx(const _T* pSrc, int len, _T* pMax, int* pIndx);
+        _SIMD_OCL_T void minMaxIndx(const _T* pSrc, int len, _T* pMin, int* pMinIndx, _T* pMax, int* pMaxIndx);
+
+        _SIMD_OCL_T void sum(const _T* pSrc, int len, _T* pSum);
+        _SIMD_OCL_T void meanStdDev(const _T* pSrc, int len, _T* pMean, _T* pStdDev);
+
+        template<typename _T> inline void mean(const _T* pSrc, int len, _T* pMean)
+        {
+            sum(pSrc, len, pMean);
+            *pMean /= len;
+        }
+
+        template<typename _T> inline void stdDev(const _T* pSrc, int len, _T* pStdDev)
+        {
+            _T m;
+            meanStdDev(pSrc, len, &m, pStdDev);
+        }
+
+        _SIMD_OCL_T void dotProd(const _T* pSrc1, const _T* pSrc2, int len, _T* pDp);
+
+        // 16-bit float storage, float accumulators on the host
+        inline void sum(const simd::float16_t* pSrc, int len, float* pSum) { nosimd::statistical::sum(pSrc, len, pSum); }
+        inline void sum(const simd::bfloat16_t* pSrc, int len, float* pSum) { nosimd::statistical::sum(pSrc, len, pSum); }
+        inline void dotProd(const simd::float16_t* pSrc1, const simd::float16_t* pSrc2, int len, float* pDp)
+        {
+            nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        }
+        inline void dotProd(const simd::bfloat16_t* pSrc1, const simd::bfloat16_t* pSrc2, int len, float* pDp)
+        {
+            nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        }
+
+        _SIMD_OCL_T void normInf(const _T* pSrc, int len, _T* pNorm);
+        _SIMD_OCL_T void normL1(const _T* pSrc, int len, _T* pNorm);
+        _SIMD_OCL_T void normL2(const _T* pSrc, int len, _T* pNorm);
+        _SIMD_OCL_T void normDiffInf(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
+        _SIMD_OCL_T void normDiffL1(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
+        _SIMD_OCL_T void normDiffL2(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
+
+        // device-resident variants, float and double only
+        _SIMD_OCL_T void min(const DeviceArray<_T>& src, _T* pMin);
+        _SIMD_OCL_T void max(const DeviceArray<_T>& src, _T* pMax);
+        _SIMD_OCL_T void minMax(const DeviceArray<_T>& src, _T* pMin, _T* pMax);
+
+        _SIMD_OCL_T void minIndx(const DeviceArray<_T>& src, _T* pMin, int* pIndx);
+        _SIMD_OCL_T void maxIndx(const DeviceArray<_T>& src, _T* pMax, int* pIndx);
+        _SIMD_OCL_T void minMaxIndx(const DeviceArray<_T>& src, _T* pMin, int* pMinIndx, _T* pMax, int* pMaxIndx);
+
+        _SIMD_OCL_T void sum(const DeviceArray<_T>& src, _T* pSum);
+        _SIMD_OCL_T void meanStdDev(const DeviceArray<_T>& src, _T* pMean, _T* pStdDev);
+        _SIMD_OCL_T void dotProd(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T* pDp);
+
+        _SIMD_OCL_T void normInf(const DeviceArray<_T>& src, _T* pNorm);
+        _SIMD_OCL_T void normL1(const DeviceArray<_T>& src, _T* pNorm);
+        _SIMD_OCL_T void normL2(const DeviceArray<_T>& src, _T* pNorm);
+        _SIMD_OCL_T void normDiffInf(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T* pNorm);
+        _SIMD_OCL_T void normDiffL1(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T* pNorm);
+        _SIMD_OCL_T void normDiffL2(const DeviceArray<_T>& src1, const DeviceArray<_T>& src2, _T* pNorm);
+    }
+
+    /// float and double run on the device with f24/d53 accuracy, other types stay on the host.
+    /// f21 takes native_* builtins where OpenCL has them, d50 builds with -cl-fast-relaxed-math.
+    namespace power
+    {
+        _SIMD_OCL_T void inv(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void sqrt(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void invSqrt(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void cbrt(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void powx(const _T* pSrc, const _T constValue, _T* pDst, int len);
+        _SIMD_OCL_T void pow(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len);
+        _SIMD_OCL_T void hypot(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len);
+
+        namespace f21
+        {
+            void inv(const float * pSrc, float * pDst, int len);
+            void sqrt(const float * pSrc, float * pDst, int len);
+            void invSqrt(const float * pSrc, float * pDst, int len);
+            void cbrt(const float * pSrc, float * pDst, int len);
+            void powx(const float * pSrc, const float constValue, float * pDst, int len);
+            void pow(const float * pSrc1, const float * pSrc2, float * pDst, int len);
+            void hypot(const float * pSrc1, const float * pSrc2, float * pDst, int len);
+        }
+
+        namespace f24
+        {
+            void inv(const float * pSrc, float * pDst, int len);
+            void sqrt(const float * pSrc, float * pDst, int len);
+            void invSqrt(const float * pSrc, float * pDst, int len);
+            void cbrt(const float * pSrc, float * pDst, int len);
+            void powx(const float * pSrc, const float constValue, float * pDst, int len);
+            void pow(const float * pSrc1, const float * pSrc2, float * pDst, int len);
+            void hypot(const float * pSrc1, const float * pSrc2, float * pDst, int len);
+        }
+
+        namespace d50
+        {
+            void inv(const double * pSrc, double * pDst, int len);
+            void sqrt(const double * pSrc, double * pDst, int len);
+            void invSqrt(const double * pSrc, double * pDst, int len);
+            void cbrt(const double * pSrc, double * pDst, int len);
+            void powx(const double * pSrc, const double constValue, double * pDst, int len);
+            void pow(const double * pSrc1, const double * pSrc2, double * pDst, int len);
+            void hypot(const double * pSrc1, const double * pSrc2, double * pDst, int len);
+        }
+
+        namespace d53
+        {
+            void inv(const double * pSrc, double * pDst, int len);
+            void sqrt(const double * pSrc, double * pDst, int len);
+            void invSqrt(const double * pSrc, double * pDst, int len);
+            void cbrt(const double * pSrc, double * pDst, int len);
+            void powx(const double * pSrc, const double constValue, double * pDst, int len);
+            void pow(const double * pSrc1, const double * pSrc2, double * pDst, int len);
+            void hypot(const double * pSrc1, const double * pSrc2, double * pDst, int len);
+        }
+    }
+
+    namespace exp_log
+    {
+        _SIMD_OCL_T void exp(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void ln(const _T* pSrc, _T* pDst, int len);
+
+        namespace f21
+        {
+            void exp(const float * pSrc, float * pDst, int len);
+            void ln(const float * pSrc, float * pDst, int len);
+        }
+
+        namespace f24
+        {
+            void exp(const float * pSrc, float * pDst, int len);
+            void ln(const float * pSrc, float * pDst, int len);
+        }
+
+        namespace d50
+        {
+            void exp(const double * pSrc, double * pDst, int len);
+            void ln(const double * pSrc, double * pDst, int len);
+        }
+
+        namespace d53
+        {
+            void exp(const double * pSrc, double * pDst, int len);
+            void ln(const double * pSrc, double * pDst, int len);
+        }
+    }
+
+    namespace trigonometric
+    {
+        _SIMD_OCL_T void sin(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void cos(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void tan(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void asin(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void acos(const _T* pSrc, _T* pDst, int len);
+        _SIMD_OCL_T void atan(const _T* pSrc, _T* pDst, int len);
+
+        namespace f21
+        {
+            void sin(const float * pSrc, float * pDst, int len);
+            void cos(const float * pSrc, float * pDst, int len);
+            void tan(const float * pSrc, float * pDst, int len);
+            void asin(const float * pSrc, float * pDst, int len);
+            void acos(const float * pSrc, float * pDst, int len);
+            void atan(const float * pSrc, float * pDst, int len);
+        }
+
+        namespace f24
+        {
+            void sin(const float * pSrc, float * pDst, int len);
+            void cos(const float * pSrc, float * pDst, int len);
+            void tan(const float * pSrc, float * pDst, int len);
+            void asin(const float * pSrc, float * pDst, int len);
+            void acos(const float * pSrc, float * pDst, int len);
+            void atan(const float * pSrc, float * pDst, int len);
+        }
+
+        namespace d50
+        {
+            void sin(const double * pSrc, double * pDst, int len);
+            void cos(const double * pSrc, double * pDst, int len);
+            void tan(const double * pSrc, double * pDst, int len);
+            void asin(const double * pSrc, double * pDst, int len);
+            void acos(const double * pSrc, double * pDst, int len);
+            void atan(const double * pSrc, double * pDst, int len);
+        }
+
+        namespace d53
+        {
+            void sin(const double * pSrc, double * pDst, int len);
+            void cos(const double * pSrc, double * pDst, int len);
+            void tan(const double * pSrc, double * pDst, int len);
+            void asin(const double * pSrc, double * pDst, int len);
+            void acos(const double * pSrc, double * pDst, int len);
+            void atan(const double * pSrc, double * pDst, int len);
+        }
+    }
+
+    /// Non-blocking variants: enqueue the whole write-kernel-read sequence and return at once.
+    /// Host buffers must stay valid until the returned Event completes.
+    namespace async
+    {
+        _SIMD_OCL_T Event addC(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event add(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, const EventList& waitFor = EventList());
+
+        _SIMD_OCL_T Event subC(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event subCRev(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event sub(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, const EventList& waitFor = EventList());
+
+        _SIMD_OCL_T Event mulC(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event mul(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, const EventList& waitFor = EventList());
+
+        _SIMD_OCL_T Event divC(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event divCRev(const _T* pSrc, _T val, _T* pDst, int len, const EventList& waitFor = EventList());
+        _SIMD_OCL_T Event div(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, const EventList& waitFor = EventList());
+
+        _SIMD_OCL_T Event abs(const _T* pSrc, _T* pDst, int len, const EventList& waitFor = EventList());
+    }
+
+    namespace internals
+    {
+        /// Node of a fused expression: an input array, a scalar kernel argument or an op over one or two children
+        _SIMD_OCL_T struct ExprNode
+        {
+            enum Kind { Input, Scalar, Unary, Binary, Call2 };
+
+            Kind kind;
+            const char * op = nullptr; // infix operator for Binary, OpenCL builtin for Unary and Call2
+            std::shared_ptr<const ExprNode> left;
+            std::shared_ptr<const ExprNode> right;
+            DeviceArray<_T> array;
+            _T value = _T(0);
+        };
+    }
+
+    /// Elementwise expressions over DeviceArrays. Operators only record the op graph; evaluate() turns
+    /// the whole graph into one kernel, so a formula of N ops costs one launch and one pass over memory
+    /// instead of N. Kernels are compiled once per expression shape: scalars are kernel arguments and
+    /// changing them does not rebuild anything.
+    ///
+    ///     using ocl::fused::Expr;
+    ///     Expr<float> x(a);
+    ///     Expr<float> y(b);
+    ///     ocl::fused::evaluate(sqrt(x * x + y * y) * 0.5f, dst);
+    namespace fused
+    {
+        _SIMD_OCL_T class Expr
+        {
+        public:
+            using Node = internals::ExprNode<_T>;
+
+            Expr(const DeviceArray<_T>& src) : node_(make(Node::Input)) { node_->array = src; }
+            Expr(_T val) : node_(make(Node::Scalar)) { node_->value = val; }
+
+            std::shared_ptr<const Node> node() const { return node_; }
+
+            friend Expr operator + (const Expr& a, const Expr& b) { return binary(Node::Binary, "+", a, b); }
+            friend Expr operator - (const Expr& a, const Expr& b) { return binary(Node::Binary, "-", a, b); }
+            friend Expr operator * (const Expr& a, const Expr& b) { return binary(Node::Binary, "*", a, b); }
+            friend Expr operator / (const Expr& a, const Expr& b) { return binary(Node::Binary, "/", a, b); }
+            friend Expr operator - (const Expr& a) { return unary("-", a); }
+
+            friend Expr min(const Expr& a, const Expr& b) { return binary(Node::Call2, "min", a, b); }
+            friend Expr max(const Expr& a, const Expr& b) { return binary(Node::Call2, "max", a, b); }
+            friend Expr abs(const Expr& a) { return unary(std::is_floating_point<_T>::value ? "fabs" : "abs", a); }
+
+            friend Expr sqrt(const Expr& a) { return floatUnary("sqrt", a); }
+            friend Expr invSqrt(const Expr& a) { return floatUnary("rsqrt", a); }
+            friend Expr cbrt(const Expr& a) { return floatUnary("cbrt", a); }
+            friend Expr exp(const Expr& a) { return floatUnary("exp", a); }
+            friend Expr ln(const Expr& a) { return floatUnary("log", a); }
+            friend Expr sin(const Expr& a) { return floatUnary("sin", a); }
+            friend Expr cos(const Expr& a) { return floatUnary("cos", a); }
+            friend Expr tan(const Expr& a) { return floatUnary("tan", a); }
+            friend Expr pow(const Expr& a, const Expr& b) { return floatBinary("pow", a, b); }
+            friend Expr hypot(const Expr& a, const Expr& b) { return floatBinary("hypot", a, b); }
+
+        private:
+            std::shared_ptr<Node> node_;
+
+            explicit Expr(std::shared_ptr<Node> node) : node_(node) {}
+
+            static std::shared_ptr<Node> make(typename Node::Kind kind)
+            {
+                std::shared_ptr<Node> node = std::make_shared<Node>();
+                node->kind = kind;
+                return node;
+            }
+
+            static Expr unary(const char * op, const Expr& a)
+            {
+                Expr res(make(Node::Unary));
+                res.node_->op = op;
+                res.node_->left = a.node_;
+                return res;
+            }
+
+            static Expr binary(typename Node::Kind kind, const char * op, const Expr& a, const Expr& b)
+            {
+                Expr res(make(kind));
+                res.node_->op = op;
+                res.node_->left = a.node_;
+                res.node_->right = b.node_;
+                return res;
+            }
+
+            static Expr floatUnary(const char * op, const Expr& a)
+            {
+                static_assert(std::is_floating_point<_T>::value, "float or double expression expected");
+                return unary(op, a);
+            }
+
+            static Expr floatBinary(const char * op, const Expr& a, const Expr& b)
+            {
+                static_assert(std::is_floating_point<_T>::value, "float or double expression expected");
+                return binary(Node::Call2, op, a, b);
+            }
+        };
+
+        /// All input arrays must have the same size and context
+        _SIMD_OCL_T void evaluate(const Expr<_T>& expr, DeviceArray<_T>& dst);
+
+        /// Expression kernels built on ctx so far, one per expression shape
+        size_t kernelCount(const Context& ctx);
     }
 
     using namespace ocl::common;
     using namespace ocl::arithmetic;
+    using namespace ocl::statistical;
+    using namespace ocl::power;
+    using namespace ocl::exp_log;
+    using namespace ocl::trigonometric;
 
     using namespace nosimd::compare;
-    using namespace nosimd::power;
-    using namespace nosimd::statistical;
-    using namespace nosimd::exp_log;
-    using namespace nosimd::trigonometric;
+
+    namespace f21
+    {
+        using namespace ocl::power::f21;
+        using namespace ocl::exp_log::f21;
+        using namespace ocl::trigonometric::f21;
+    }
+
+    namespace f24
+    {
+        using namespace ocl::power::f24;
+        using namespace ocl::exp_log::f24;
+        using namespace ocl::trigonometric::f24;
+    }
+
+    namespace d50
+    {
+        using namespace ocl::power::d50;
+        using namespace ocl::exp_log::d50;
+        using namespace ocl::trigonometric::d50;
+    }
+
+    namespace d53
+    {
+        using namespace ocl::power::d53;
+        using namespace ocl::exp_log::d53;
+        using namespace ocl::trigonometric::d53;
+    }
 }
@@ -1,6 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <string>
+#include <type_traits>
+#include <cctype>
+#include <vector>
 
 namespace ocl
 {
@@ -8,6 +11,39 @@ namespace internals
 {
 namespace Kernel
 {
+    /// Accuracy of the transcendental kernels, after the IPP f21/f24/d50/d53 split
+    enum class Precision : uint32_t
+    {
+        Accurate,   // OpenCL builtins within their spec ulp bounds: f24, d53
+        Native,     // native_* builtins where the type has them, accuracy is device defined: f21
+        Relaxed,    // builtins compiled with -cl-fast-relaxed-math: d50
+        Count
+    };
+
+    enum class MathOp : uint32_t
+    {
+        Inv,
+        Sqrt,
+        InvSqrt,
+        Cbrt,
+        Exp,
+        Ln,
+        Sin,
+        Cos,
+        Tan,
+        Asin,
+        Acos,
+        Atan,
+        Powx,
+        Pow,
+        Hypot,
+        Count
+    };
+
+    /// Kernels per item type: every op in every precision
+    inline constexpr uint32_t mathCount() { return (uint32_t)MathOp::Count * (uint32_t)Precision::Count; }
+    inline constexpr uint32_t mathIndex(MathOp op, Precision prec) { return (uint32_t)prec * (uint32_t)MathOp::Count + (uint32_t)op; }
+
     enum class Func : uint32_t
     {
         Add_8s,
@@ -126,7 +162,36 @@ namespace Kernel
         DivCRev_64f,
         Abs_64f,
         //
-        Count
+        ReduceSum_32f,
+        ReduceMin_32f,
+        ReduceMax_32f,
+        ReduceDot_32f,
+        ReduceSqDev_32f,
+        ReduceL1_32f,
+        ReduceInf_32f,
+        ReduceDiffL1_32f,
+        ReduceDiffL2_32f,
+        ReduceDiffInf_32f,
+        ReduceMinIndx_32f,
+        ReduceMaxIndx_32f,
+        //
+        ReduceSum_64f,
+        ReduceMin_64f,
+        ReduceMax_64f,
+        ReduceDot_64f,
+        ReduceSqDev_64f,
+        ReduceL1_64f,
+        ReduceInf_64f,
+        ReduceDiffL1_64f,
+        ReduceDiffL2_64f,
+        ReduceDiffInf_64f,
+        ReduceMinIndx_64f,
+        ReduceMaxIndx_64f,
+        //
+        Math_32f,
+        Math_64f = Math_32f + mathCount(),
+        //
+        Count = Math_64f + mathCount()
     };
 
     inline constexpr uint32_t funcCount() { return (uint32_t)Func::Count; }
@@ -136,30 +201,133 @@ namespace Kernel
     {
         const char * name = nullptr;
         const char * text = nullptr;
+        uint32_t group = 0; // kernels of one item type are compiled together
+        uint32_t width = 1; // elements per work item
 
         template <typename _T>
         static constexpr TextProgram create()
         {
-            return {_T::programName(), _T::programText()};
+            using ItemType = typename _T::ItemType;
+            return {_T::programName(), _T::programText(), typeGroup<ItemType>(), vectorWidth<ItemType>()};
         }
 
+        /// One 16-byte vector per work item: char16, short8, int4, long2, float4, double2
+        template <typename _T>
+        static constexpr uint32_t vectorWidth() { return 16 / sizeof(_T); }
+
+        template <typename _T>
+        static constexpr uint32_t typeGroup();
+
         template <typename _T>
         static constexpr const char * typeStr();
 
+        /// operation is an expression of x (from a) and y (from b). Full vectors go through vloadN/vstoreN,
+        /// the last work item finishes the remainder element by element.
         template <typename _T1, typename _T2, typename _T3>
         static std::string func3args(const char * func, const char * operation)
         {
+            using ItemType = typename std::remove_pointer<_T3>::type;
+            static constexpr uint32_t w = vectorWidth<ItemType>();
+            const char * item = typeStr<ItemType>();
+
+            char vecB[64];
+            char itemB[16];
+            if (std::is_pointer<_T2>::value)
+            {
+                snprintf(vecB, sizeof(vecB), "vload%u(i, b)", w);
+                snprintf(itemB, sizeof(itemB), "b[k]");
+            }
+            else
+            {
+                snprintf(vecB, sizeof(vecB), "(%s%u)(b)", item, w);
+                snprintf(itemB, sizeof(itemB), "b");
+            }
+
             static const char * funcTemplate =
                 "__kernel void %s(%s a, %s b, %s c, int size) {"
-                " int iGID = get_global_id(0);"
-                " if (iGID >= size) return;"
-                " %s; }";
+                " int i = get_global_id(0);"
+                " int base = i * %u;"
+                " if (base + %u <= size) {"
+                " %s%u x = vload%u(i, a); %s%u y = %s; vstore%u(%s, i, c); }"
+                " else for (int k = base; k < size; ++k) {"
+                " %s x = a[k]; %s y = %s; c[k] = %s; } }";
             char buf[1024];
-            snprintf(buf, 1024, funcTemplate, func, typeStr<_T1>(), typeStr<_T2>(), typeStr<_T3>(), operation);
+            snprintf(buf, 1024, funcTemplate, func, typeStr<_T1>(), typeStr<_T2>(), typeStr<_T3>(),
+                     w, w,
+                     item, w, w, item, w, vecB, w, operation,
+                     item, item, itemB, operation);
             return std::string(buf);
         }
     };
 
+    /// One group per item type plus the relaxed-math groups of float (10) and double (11)
+    inline constexpr uint32_t groupCount() { return 12; }
+    inline constexpr const char * groupOptions(uint32_t group) { return group < 10 ? "" : "-cl-fast-relaxed-math"; }
+
+    template <> constexpr uint32_t TextProgram::typeGroup<int8_t>() { return 0; }
+    template <> constexpr uint32_t TextProgram::typeGroup<uint8_t>() { return 1; }
+    template <> constexpr uint32_t TextProgram::typeGroup<int16_t>() { return 2; }
+    template <> constexpr uint32_t TextProgram::typeGroup<uint16_t>() { return 3; }
+    template <> constexpr uint32_t TextProgram::typeGroup<int32_t>() { return 4; }
+    template <> constexpr uint32_t TextProgram::typeGroup<uint32_t>() { return 5; }
+    template <> constexpr uint32_t TextProgram::typeGroup<int64_t>() { return 6; }
+    template <> constexpr uint32_t TextProgram::typeGroup<uint64_t>() { return 7; }
+    template <> constexpr uint32_t TextProgram::typeGroup<float>() { return 8; }
+    template <> constexpr uint32_t TextProgram::typeGroup<double>() { return 9; }
+
+    /// Work-group tree reduction. The first pass folds map(x) over a grid-stride slice per work item,
+    /// the final pass (final != 0) folds the per-group partials inside one group.
+    /// map sees x = a[i], b[i] and the scalar c; fold is a builtin name or an infix operator.
+    template <typename _T>
+    inline std::string reduceText(const char * func, const char * map, const char * fold, const char * identity)
+    {
+        const char * t = TextProgram::typeStr<_T>();
+        auto folded = [fold](const std::string& l, const std::string& r)
+        {
+            if (isalpha(static_cast<unsigned char>(fold[0])))
+                return std::string(fold) + "(" + l + ", " + r + ")";
+            return "(" + l + " " + fold + " " + r + ")";
+        };
+
+        std::string text;
+        text += std::string("__kernel void ") + func + "(__global const " + t + "* a, __global const " + t + "* b, "
+            + t + " c, int size, int final, __global " + t + "* out, __local " + t + "* scratch) {";
+        text += std::string(" int lid = get_local_id(0); ") + t + " acc = " + identity + ";";
+        text += " for (int i = get_global_id(0); i < size; i += get_global_size(0)) {";
+        text += std::string(" ") + t + " x = a[i]; " + t + " v = final ? x : (" + map + ");";
+        text += " acc = " + folded("acc", "v") + "; }";
+        text += " scratch[lid] = acc; barrier(CLK_LOCAL_MEM_FENCE);";
+        text += " for (int s = get_local_size(0) / 2; s > 0; s >>= 1) {";
+        text += " if (lid < s) scratch[lid] = " + folded("scratch[lid]", "scratch[lid + s]") + ";";
+        text += " barrier(CLK_LOCAL_MEM_FENCE); }";
+        text += " if (lid == 0) out[get_group_id(0)] = scratch[0]; }";
+        return text;
+    }
+
+    /// Value and index reduction; ties go to the lower index. ai is NULL in the first pass.
+    template <typename _T>
+    inline std::string reduceIndxText(const char * func, const char * cmp, const char * identity)
+    {
+        const char * t = TextProgram::typeStr<_T>();
+        std::string better = std::string("(x ") + cmp + " bv || (x == bv && xi < bi))";
+
+        std::string text;
+        text += std::string("__kernel void ") + func + "(__global const " + t + "* a, __global const int* ai, int size,"
+            " __global " + t + "* outVal, __global int* outIdx, __local " + t + "* sVal, __local int* sIdx) {";
+        text += std::string(" int lid = get_local_id(0); ") + t + " bv = " + identity + "; int bi = INT_MAX;";
+        text += " for (int i = get_global_id(0); i < size; i += get_global_size(0)) {";
+        text += std::string(" ") + t + " x = a[i]; int xi = ai ? ai[i] : i;";
+        text += " if " + better + " { bv = x; bi = xi; } }";
+        text += " sVal[lid] = bv; sIdx[lid] = bi; barrier(CLK_LOCAL_MEM_FENCE);";
+        text += " for (int s = get_local_size(0) / 2; s > 0; s >>= 1) {";
+        text += std::string(" if (lid < s) { ") + t + " x = sVal[lid + s]; int xi = sIdx[lid + s];";
+        text += std::string(" ") + t + " bv = sVal[lid]; int bi = sIdx[lid];";
+        text += " if " + better + " { sVal[lid] = x; sIdx[lid] = xi; } }";
+        text += " barrier(CLK_LOCAL_MEM_FENCE); }";
+        text += " if (lid == 0) { outVal[get_group_id(0)] = sVal[0]; outIdx[get_group_id(0)] = sIdx[0]; } }";
+        return text;
+    }
+
     template <> constexpr const char * TextProgram::typeStr<int8_t>() { return "char"; }
     template <> constexpr const char * TextProgram::typeStr<uint8_t>() { return "uchar"; }
     template <> constexpr const char * TextProgram::typeStr<int16_t>() { return "short"; }
@@ -200,10 +368,10 @@ namespace Kernel
         using DataTypeDst = _T*;
         using BaseType = PtrPtrPtr<_T>;
 
-        static constexpr const char * opAdd() { return "c[iGID] = a[iGID] + b[iGID]"; }
-        static constexpr const char * opSub() { return "c[iGID] = a[iGID] - b[iGID]"; }
-        static constexpr const char * opMul() { return "c[iGID] = a[iGID] * b[iGID]"; }
-        static constexpr const char * opDiv() { return "c[iGID] = a[iGID] / b[iGID]"; }
+        static constexpr const char * opAdd() { return "(x + y)"; }
+        static constexpr const char * opSub() { return "(x - y)"; }
+        static constexpr const char * opMul() { return "(x * y)"; }
+        static constexpr const char * opDiv() { return "(x / y)"; }
     };
 
     template <typename _T>
@@ -215,16 +383,16 @@ namespace Kernel
         using DataTypeDst = _T*;
         using BaseType = PtrValPtr<_T>;
 
-        static constexpr const char * opAddC() { return "c[iGID] = a[iGID] + b"; }
-        static constexpr const char * opSubC() { return "c[iGID] = a[iGID] - b"; }
-        static constexpr const char * opMulC() { return "c[iGID] = a[iGID] * b"; }
-        static constexpr const char * opDivC() { return "c[iGID] = a[iGID] / b"; }
-        static constexpr const char * opSubCRev() { return "c[iGID] = b - a[iGID]"; }
-        static constexpr const char * opDivCRev() { return "c[iGID] = b / a[iGID]"; }
+        static constexpr const char * opAddC() { return "(x + y)"; }
+        static constexpr const char * opSubC() { return "(x - y)"; }
+        static constexpr const char * opMulC() { return "(x * y)"; }
+        static constexpr const char * opDivC() { return "(x / y)"; }
+        static constexpr const char * opSubCRev() { return "(y - x)"; }
+        static constexpr const char * opDivCRev() { return "(y / x)"; }
 
         static constexpr const char * opAbs()
         {
-            return "if (a[iGID] < 0) c[iGID] = -a[iGID]; else c[iGID] = a[iGID]";
+            return "(x < 0 ? -x : x)";
         }
     };
 
@@ -587,8 +755,312 @@ namespace Kernel
 
     //
 
-    inline constexpr TextProgram program(Func func)
+    template <typename _T>
+    struct Reduction
+    {
+        using ItemType = _T;
+        using BaseType = Reduction<_T>;
+    };
+
+    template <typename _T>
+    struct IndexedReduction
+    {
+        using ItemType = _T;
+        using BaseType = IndexedReduction<_T>;
+    };
+
+    template <typename _T>
+    struct ReduceSum : public Reduction<_T>
     {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "x", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceSum<float>::id() { return Func::ReduceSum_32f; }
+    template <> constexpr Func ReduceSum<double>::id() { return Func::ReduceSum_64f; }
+    template <> constexpr const char * ReduceSum<float>::programName() { return "sum_32f"; }
+    template <> constexpr const char * ReduceSum<double>::programName() { return "sum_64f"; }
+
+    template <typename _T>
+    struct ReduceMin : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "x", "fmin", "INFINITY");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceMin<float>::id() { return Func::ReduceMin_32f; }
+    template <> constexpr Func ReduceMin<double>::id() { return Func::ReduceMin_64f; }
+    template <> constexpr const char * ReduceMin<float>::programName() { return "min_32f"; }
+    template <> constexpr const char * ReduceMin<double>::programName() { return "min_64f"; }
+
+    template <typename _T>
+    struct ReduceMax : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "x", "fmax", "-INFINITY");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceMax<float>::id() { return Func::ReduceMax_32f; }
+    template <> constexpr Func ReduceMax<double>::id() { return Func::ReduceMax_64f; }
+    template <> constexpr const char * ReduceMax<float>::programName() { return "max_32f"; }
+    template <> constexpr const char * ReduceMax<double>::programName() { return "max_64f"; }
+
+    template <typename _T>
+    struct ReduceDot : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "x * b[i]", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceDot<float>::id() { return Func::ReduceDot_32f; }
+    template <> constexpr Func ReduceDot<double>::id() { return Func::ReduceDot_64f; }
+    template <> constexpr const char * ReduceDot<float>::programName() { return "dot_32f"; }
+    template <> constexpr const char * ReduceDot<double>::programName() { return "dot_64f"; }
+
+    template <typename _T>
+    struct ReduceSqDev : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "(x - c) * (x - c)", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceSqDev<float>::id() { return Func::ReduceSqDev_32f; }
+    template <> constexpr Func ReduceSqDev<double>::id() { return Func::ReduceSqDev_64f; }
+    template <> constexpr const char * ReduceSqDev<float>::programName() { return "sqDev_32f"; }
+    template <> constexpr const char * ReduceSqDev<double>::programName() { return "sqDev_64f"; }
+
+    template <typename _T>
+    struct ReduceL1 : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "fabs(x)", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceL1<float>::id() { return Func::ReduceL1_32f; }
+    template <> constexpr Func ReduceL1<double>::id() { return Func::ReduceL1_64f; }
+    template <> constexpr const char * ReduceL1<float>::programName() { return "sumAbs_32f"; }
+    template <> constexpr const char * ReduceL1<double>::programName() { return "sumAbs_64f"; }
+
+    template <typename _T>
+    struct ReduceInf : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "fabs(x)", "fmax", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceInf<float>::id() { return Func::ReduceInf_32f; }
+    template <> constexpr Func ReduceInf<double>::id() { return Func::ReduceInf_64f; }
+    template <> constexpr const char * ReduceInf<float>::programName() { return "maxAbs_32f"; }
+    template <> constexpr const char * ReduceInf<double>::programName() { return "maxAbs_64f"; }
+
+    template <typename _T>
+    struct ReduceDiffL1 : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "fabs(x - b[i])", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceDiffL1<float>::id() { return Func::ReduceDiffL1_32f; }
+    template <> constexpr Func ReduceDiffL1<double>::id() { return Func::ReduceDiffL1_64f; }
+    template <> constexpr const char * ReduceDiffL1<float>::programName() { return "sumAbsDiff_32f"; }
+    template <> constexpr const char * ReduceDiffL1<double>::programName() { return "sumAbsDiff_64f"; }
+
+    template <typename _T>
+    struct ReduceDiffL2 : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "(x - b[i]) * (x - b[i])", "+", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceDiffL2<float>::id() { return Func::ReduceDiffL2_32f; }
+    template <> constexpr Func ReduceDiffL2<double>::id() { return Func::ReduceDiffL2_64f; }
+    template <> constexpr const char * ReduceDiffL2<float>::programName() { return "sumSqDiff_32f"; }
+    template <> constexpr const char * ReduceDiffL2<double>::programName() { return "sumSqDiff_64f"; }
+
+    template <typename _T>
+    struct ReduceDiffInf : public Reduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceText<_T>(programName(), "fabs(x - b[i])", "fmax", "0");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceDiffInf<float>::id() { return Func::ReduceDiffInf_32f; }
+    template <> constexpr Func ReduceDiffInf<double>::id() { return Func::ReduceDiffInf_64f; }
+    template <> constexpr const char * ReduceDiffInf<float>::programName() { return "maxAbsDiff_32f"; }
+    template <> constexpr const char * ReduceDiffInf<double>::programName() { return "maxAbsDiff_64f"; }
+
+    template <typename _T>
+    struct ReduceMinIndx : public IndexedReduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceIndxText<_T>(programName(), "<", "INFINITY");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceMinIndx<float>::id() { return Func::ReduceMinIndx_32f; }
+    template <> constexpr Func ReduceMinIndx<double>::id() { return Func::ReduceMinIndx_64f; }
+    template <> constexpr const char * ReduceMinIndx<float>::programName() { return "minIndx_32f"; }
+    template <> constexpr const char * ReduceMinIndx<double>::programName() { return "minIndx_64f"; }
+
+    template <typename _T>
+    struct ReduceMaxIndx : public IndexedReduction<_T>
+    {
+        static constexpr Func id();
+        static constexpr const char * programName();
+        static const char * programText()
+        {
+            static std::string text = reduceIndxText<_T>(programName(), ">", "-INFINITY");
+            return text.data();
+        }
+    };
+
+    template <> constexpr Func ReduceMaxIndx<float>::id() { return Func::ReduceMaxIndx_32f; }
+    template <> constexpr Func ReduceMaxIndx<double>::id() { return Func::ReduceMaxIndx_64f; }
+    template <> constexpr const char * ReduceMaxIndx<float>::programName() { return "maxIndx_32f"; }
+    template <> constexpr const char * ReduceMaxIndx<double>::programName() { return "maxIndx_64f"; }
+
+    //
+
+    template <typename _T> constexpr Func mathBase();
+    template <> constexpr Func mathBase<float>() { return Func::Math_32f; }
+    template <> constexpr Func mathBase<double>() { return Func::Math_64f; }
+
+    /// Unary ops ignore the scalar y, powx takes its exponent there
+    template <typename _T, MathOp _Op, Precision _P>
+    struct Math : public std::conditional<_Op == MathOp::Pow || _Op == MathOp::Hypot, PtrPtrPtr<_T>, PtrValPtr<_T>>::type
+    {
+        static constexpr Func id() { return Func((uint32_t)mathBase<_T>() + mathIndex(_Op, _P)); }
+    };
+
+    /// native_* exists for float only, the other ops keep the accurate builtin
+    inline const char * mathExpr(MathOp op, bool native)
+    {
+        switch (op) {
+            case MathOp::Inv: return native ? "native_recip(x)" : "(1 / x)";
+            case MathOp::Sqrt: return native ? "native_sqrt(x)" : "sqrt(x)";
+            case MathOp::InvSqrt: return native ? "native_rsqrt(x)" : "rsqrt(x)";
+            case MathOp::Cbrt: return "cbrt(x)";
+            case MathOp::Exp: return native ? "native_exp(x)" : "exp(x)";
+            case MathOp::Ln: return native ? "native_log(x)" : "log(x)";
+            case MathOp::Sin: return native ? "native_sin(x)" : "sin(x)";
+            case MathOp::Cos: return native ? "native_cos(x)" : "cos(x)";
+            case MathOp::Tan: return native ? "native_tan(x)" : "tan(x)";
+            case MathOp::Asin: return "asin(x)";
+            case MathOp::Acos: return "acos(x)";
+            case MathOp::Atan: return "atan(x)";
+            case MathOp::Powx: return "pow(x, y)";
+            case MathOp::Pow: return "pow(x, y)";
+            case MathOp::Hypot: return "hypot(x, y)";
+            case MathOp::Count:
+                break;
+        }
+        return nullptr;
+    }
+
+    inline const char * mathName(MathOp op)
+    {
+        static const char * names[] = {"inv", "sqrt", "invSqrt", "cbrt", "exp", "ln", "sin", "cos", "tan",
+                                       "asin", "acos", "atan", "powx", "pow", "hypot"};
+        static_assert(sizeof(names) / sizeof(names[0]) == (uint32_t)MathOp::Count, "MathOp names");
+        return names[(uint32_t)op];
+    }
+
+    /// Texts are generated once per item type. Relaxed kernels go to the relaxed-math group of the type.
+    template <typename _T>
+    inline TextProgram mathProgram(uint32_t idx)
+    {
+        struct Text { std::string name; std::string text; };
+        static const std::vector<Text> texts = []()
+        {
+            static const char * suffix[] = {"", "_native", "_relaxed"};
+            const bool isFloat = std::is_same<_T, float>::value;
+            std::vector<Text> res;
+            for (uint32_t i = 0; i < mathCount(); ++i)
+            {
+                MathOp op = MathOp(i % (uint32_t)MathOp::Count);
+                Precision prec = Precision(i / (uint32_t)MathOp::Count);
+                const char * expr = mathExpr(op, isFloat && prec == Precision::Native);
+
+                Text t;
+                t.name = std::string(mathName(op)) + (isFloat ? "_32f" : "_64f") + suffix[(uint32_t)prec];
+                if (op == MathOp::Pow || op == MathOp::Hypot)
+                    t.text = TextProgram::func3args<const _T*, const _T*, _T*>(t.name.c_str(), expr);
+                else
+                    t.text = TextProgram::func3args<const _T*, _T, _T*>(t.name.c_str(), expr);
+                res.push_back(t);
+            }
+            return res;
+        }();
+
+        bool relaxed = (idx / (uint32_t)MathOp::Count == (uint32_t)Precision::Relaxed);
+        uint32_t group = relaxed ? (std::is_same<_T, float>::value ? 10 : 11) : TextProgram::typeGroup<_T>();
+        return {texts[idx].name.c_str(), texts[idx].text.c_str(), group, TextProgram::vectorWidth<_T>()};
+    }
+
+    //
+
+    inline TextProgram program(Func func)
+    {
+        uint32_t idx = (uint32_t)func;
+        if (idx >= (uint32_t)Func::Math_32f && idx < (uint32_t)Func::Math_64f)
+            return mathProgram<float>(idx - (uint32_t)Func::Math_32f);
+        if (idx >= (uint32_t)Func::Math_64f && idx < (uint32_t)Func::Count)
+            return mathProgram<double>(idx - (uint32_t)Func::Math_64f);
+
         switch (func) {
             case Func::Add_8s: return TextProgram::create<Add<int8_t>>();
             case Func::Sub_8s: return TextProgram::create<Sub<int8_t>>();
@@ -706,11 +1178,55 @@ namespace Kernel
             case Func::Abs_64s: return TextProgram::create<Abs<int64_t>>();
             case Func::Abs_32f: return TextProgram::create<Abs<float>>();
             case Func::Abs_64f: return TextProgram::create<Abs<double>>();
+            //
+            case Func::ReduceSum_32f: return TextProgram::create<ReduceSum<float>>();
+            case Func::ReduceMin_32f: return TextProgram::create<ReduceMin<float>>();
+            case Func::ReduceMax_32f: return TextProgram::create<ReduceMax<float>>();
+            case Func::ReduceDot_32f: return TextProgram::create<ReduceDot<float>>();
+            case Func::ReduceSqDev_32f: return TextProgram::create<ReduceSqDev<float>>();
+            case Func::ReduceL1_32f: return TextProgram::create<ReduceL1<float>>();
+            case Func::ReduceInf_32f: return TextProgram::create<ReduceInf<float>>();
+            case Func::ReduceDiffL1_32f: return TextProgram::create<ReduceDiffL1<float>>();
+            case Func::ReduceDiffL2_32f: return TextProgram::create<ReduceDiffL2<float>>();
+            case Func::ReduceDiffInf_32f: return TextProgram::create<ReduceDiffInf<float>>();
+            case Func::ReduceMinIndx_32f: return TextProgram::create<ReduceMinIndx<float>>();
+            case Func::ReduceMaxIndx_32f: return TextProgram::create<ReduceMaxIndx<float>>();
+            //
+            case Func::ReduceSum_64f: return TextProgram::create<ReduceSum<double>>();
+            case Func::ReduceMin_64f: return TextProgram::create<ReduceMin<double>>();
+            case Func::ReduceMax_64f: return TextProgram::create<ReduceMax<double>>();
+            case Func::ReduceDot_64f: return TextProgram::create<ReduceDot<double>>();
+            case Func::ReduceSqDev_64f: return TextProgram::create<ReduceSqDev<double>>();
+            case Func::ReduceL1_64f: return TextProgram::create<ReduceL1<double>>();
+            case Func::ReduceInf_64f: return TextProgram::create<ReduceInf<double>>();
+            case Func::ReduceDiffL1_64f: return TextProgram::create<ReduceDiffL1<double>>();
+            case Func::ReduceDiffL2_64f: return TextProgram::create<ReduceDiffL2<double>>();
+            case Func::ReduceDiffInf_64f: return TextProgram::create<ReduceDiffInf<double>>();
+            case Func::ReduceMinIndx_64f: return TextProgram::create<ReduceMinIndx<double>>();
+            case Func::ReduceMaxIndx_64f: return TextProgram::create<ReduceMaxIndx<double>>();
+            case Func::Math_32f:
+            case Func::Math_64f:
             case Func::Count:
                 break;
         }
         return {nullptr, nullptr};
     }
+
+    /// Source of one program holding every kernel of the group
+    inline std::string groupText(uint32_t group)
+    {
+        std::string text;
+        for (uint32_t i = 0; i < funcCount(); ++i)
+        {
+            TextProgram prog = program((Func)i);
+            if (prog.text && prog.group == group)
+            {
+                text += prog.text;
+                text += '\n';
+            }
+        }
+        return text;
+    }
 }
 } // internals
 } // ocl
@@ -1,32 +1,49 @@
 #pragma once
 #include "nosimd.h"
 
+#if defined(SIMD_INSTRUMENT)
+#define _SIMD_BACKEND simd_backend
+#else
+#define _SIMD_BACKEND simd
+#endif
+
 #if defined(NO_SIMD)
-namespace simd { using namespace nosimd; }
+namespace _SIMD_BACKEND { using namespace nosimd; }
 #elif (defined(__amd64__) || defined(__i386__) || defined(_M_AMD64))
 
 #if defined(SIMD_IPP)
 #include "sse_ipp.h"
-namespace simd { using namespace ipp; }
+namespace _SIMD_BACKEND { using namespace ipp; }
+#elif defined(SIMD_HYBRID)
+#include "hybrid.h"
+namespace _SIMD_BACKEND { using namespace hybrid; }
 #elif defined(SIMD_OPENCL)
 #include "ocl.h"
-namespace simd { using namespace ocl; }
+namespace _SIMD_BACKEND { using namespace ocl; }
 #elif defined(SIMD_AVX)
 #include "avx-float.h"
 #include "avx-double.h"
 #include "avx-int.h"
 #include "avx-convert.h"
-namespace simd { using namespace sse; }
+#include "avx-half.h"
+namespace _SIMD_BACKEND { using namespace sse; }
 #else
 #include "sse-float.h"
 #include "sse-double.h"
 #include "sse-int.h"
-namespace simd { using namespace sse; }
+#include "sse-convert.h"
+#include "sse-half.h"
+namespace _SIMD_BACKEND { using namespace sse; }
 #endif
 
 #elif defined(__arm__)
 #include "neon.h"
-namespace simd { using namespace neon; }
+namespace _SIMD_BACKEND { using namespace neon; }
 #else
-namespace simd { using namespace nosimd; }
+namespace _SIMD_BACKEND { using namespace nosimd; }
+#endif
+
+#if defined(SIMD_INSTRUMENT)
+#include "instrument.h"
+namespace simd { using namespace instrument; }
 #endif
@@ -0,0 +1,485 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <smmintrin.h>
+
+#include "sse.h"
+
+namespace sse
+{
+namespace internals
+{
+    /// One vector of _D per step from the low bytes of a load of _S
+    template <typename _S, typename _D, __m128i (*cvt)(__m128i)>
+    INLINE void widen(const _S * pSrc, _D * pDst, int len)
+    {
+        constexpr int step = 16 / sizeof(_D);
+        int tail = len % step;
+        const _S * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m128i a = sse_load_low<step * sizeof(_S)>(pSrc);
+            sse_store_si((__m128i*)pDst, cvt(a));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = (_D)pSrc[i];
+    }
+
+    /// Keeps the low half of every item, as a cast does: masked items never saturate in an unsigned pack
+    template <typename _S, typename _D, __m128i (*pack)(__m128i, __m128i)>
+    INLINE void narrow(const _S * pSrc, _D * pDst, int len)
+    {
+        constexpr int step = 16 / sizeof(_D);
+        int tail = len % step;
+        const _S * pEnd = pSrc + (len-tail);
+        const __m128i mask = (sizeof(_D) == 1) ? _mm_set1_epi16(0xff) : _mm_set1_epi32(0xffff);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m128i a = _mm_and_si128(sse_load_si((const __m128i*)pSrc), mask);
+            __m128i b = _mm_and_si128(sse_load_si((const __m128i*)pSrc + 1), mask);
+            sse_store_si((__m128i*)pDst, pack(a, b));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = (_D)pSrc[i];
+    }
+
+    /// Four items per step. Float to int32 truncates as a cast does.
+    INLINE void convert(const float * pSrc, double * pDst, int len)
+    {
+        int tail = len % 4;
+        const float * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+        {
+            __m128 a = sse_load_ps(pSrc);
+            sse_store_pd(pDst, _mm_cvtps_pd(a));
+            sse_store_pd(pDst + 2, _mm_cvtps_pd(_mm_movehl_ps(a, a)));
+        }
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    INLINE void convert(const float * pSrc, int32_t * pDst, int len)
+    {
+        int tail = len % 4;
+        const float * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+            sse_store_si((__m128i*)pDst, _mm_cvttps_epi32(sse_load_ps(pSrc)));
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    INLINE void convert(const int32_t * pSrc, float * pDst, int len)
+    {
+        int tail = len % 4;
+        const int32_t * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+            sse_store_ps(pDst, _mm_cvtepi32_ps(sse_load_si((const __m128i*)pSrc)));
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    INLINE void convert(const int32_t * pSrc, double * pDst, int len)
+    {
+        int tail = len % 4;
+        const int32_t * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+        {
+            __m128i a = sse_load_si((const __m128i*)pSrc);
+            sse_store_pd(pDst, _mm_cvtepi32_pd(a));
+            sse_store_pd(pDst + 2, _mm_cvtepi32_pd(_mm_unpackhi_epi64(a, a)));
+        }
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    INLINE void convert(const double * pSrc, float * pDst, int len)
+    {
+        int tail = len % 4;
+        const double * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+        {
+            __m128 a = _mm_cvtpd_ps(sse_load_pd(pSrc));
+            __m128 b = _mm_cvtpd_ps(sse_load_pd(pSrc + 2));
+            sse_store_ps(pDst, _mm_movelh_ps(a, b));
+        }
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    INLINE void convert(const double * pSrc, int32_t * pDst, int len)
+    {
+        int tail = len % 4;
+        const double * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+        {
+            __m128i a = _mm_cvttpd_epi32(sse_load_pd(pSrc));
+            __m128i b = _mm_cvttpd_epi32(sse_load_pd(pSrc + 2));
+            sse_store_si((__m128i*)pDst, _mm_unpacklo_epi64(a, b));
+        }
+
+        nosimd::common::convert(pSrc, pDst, tail);
+    }
+
+    /// Four items of _S to float per step, times scale plus offset when scaled
+    template <typename _S, __m128i (*cvt)(__m128i), bool scaled>
+    INLINE void toFloat(const _S * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        int tail = len % 4;
+        const _S * pEnd = pSrc + (len-tail);
+        const __m128 s = _mm_set1_ps(scale);
+        const __m128 o = _mm_set1_ps(offset);
+
+        for (; pSrc < pEnd; pSrc += 4, pDst += 4)
+        {
+            __m128 a = _mm_cvtepi32_ps(cvt(sse_load_low<4 * sizeof(_S)>(pSrc)));
+            if (scaled)
+                a = _mm_add_ps(_mm_mul_ps(a, s), o);
+            sse_store_ps(pDst, a);
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = scaled ? (pSrc[i] * scale + offset) : pSrc[i];
+    }
+
+    template <bool scaled>
+    INLINE __m128i truncate(const float * pSrc, __m128 s, __m128 o, __m128i mask)
+    {
+        __m128 a = sse_load_ps(pSrc);
+        if (scaled)
+            a = _mm_add_ps(_mm_mul_ps(a, s), o);
+        return _mm_and_si128(_mm_cvttps_epi32(a), mask);
+    }
+
+    /// Float to 8 or 16 bit items, truncated as a cast does, 16 bytes of _D per step
+    template <typename _D, bool scaled>
+    INLINE void fromFloat(const float * pSrc, _D * pDst, int len, float scale, float offset)
+    {
+        constexpr int step = 16 / sizeof(_D);
+        int tail = len % step;
+        const float * pEnd = pSrc + (len-tail);
+        const __m128 s = _mm_set1_ps(scale);
+        const __m128 o = _mm_set1_ps(offset);
+        const __m128i mask = _mm_set1_epi32((sizeof(_D) == 1) ? 0xff : 0xffff);
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m128i a = _mm_packus_epi32(truncate<scaled>(pSrc, s, o, mask), truncate<scaled>(pSrc + 4, s, o, mask));
+            if (sizeof(_D) == 1)
+            {
+                __m128i b = _mm_packus_epi32(truncate<scaled>(pSrc + 8, s, o, mask), truncate<scaled>(pSrc + 12, s, o, mask));
+                a = _mm_packus_epi16(a, b);
+            }
+            sse_store_si((__m128i*)pDst, a);
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = scaled ? (_D)(pSrc[i] * scale + offset) : (_D)pSrc[i];
+    }
+
+    /// Rounded by rnd, NaN as 0 and saturated to _D, in 32-bit lanes.
+    /// int32 overflow converts to 0x80000000, the xor turns it into INT_MAX on the positive side.
+    template <typename _D, int rnd>
+    INLINE __m128i roundSat(const float * pSrc, __m128 s)
+    {
+        __m128 a = _mm_round_ps(_mm_mul_ps(sse_load_ps(pSrc), s), rnd | _MM_FROUND_NO_EXC);
+        a = _mm_and_ps(a, _mm_cmpord_ps(a, a));
+        if (sizeof(_D) == 4)
+        {
+            __m128i over = _mm_castps_si128(_mm_cmpge_ps(a, _mm_set1_ps(2147483648.f)));
+            return _mm_xor_si128(_mm_cvttps_epi32(a), over);
+        }
+
+        a = _mm_max_ps(a, _mm_set1_ps(std::numeric_limits<_D>::min()));
+        a = _mm_min_ps(a, _mm_set1_ps(std::numeric_limits<_D>::max()));
+        return _mm_cvttps_epi32(a);
+    }
+
+    /// Items are in range of _D before the packs, so signed and unsigned packs keep them as is
+    template <typename _D, int rnd>
+    INLINE void convertSat(const float * pSrc, _D * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        constexpr int step = 16 / sizeof(_D);
+        constexpr bool sign = std::is_signed<_D>::value;
+        int tail = len % step;
+        const float * pEnd = pSrc + (len-tail);
+        const __m128 s = _mm_set1_ps(std::ldexp(1.f, -scaleFactor));
+
+        for (; pSrc < pEnd; pSrc += step, pDst += step)
+        {
+            __m128i a = roundSat<_D, rnd>(pSrc, s);
+            if (sizeof(_D) < 4)
+            {
+                __m128i b = roundSat<_D, rnd>(pSrc + 4, s);
+                a = sign ? _mm_packs_epi32(a, b) : _mm_packus_epi32(a, b);
+            }
+            if (sizeof(_D) == 1)
+            {
+                __m128i c = roundSat<_D, rnd>(pSrc + 8, s);
+                __m128i d = roundSat<_D, rnd>(pSrc + 12, s);
+                __m128i b = _mm_packs_epi32(c, d);
+                a = sign ? _mm_packs_epi16(a, b) : _mm_packus_epi16(a, b);
+            }
+            sse_store_si((__m128i*)pDst, a);
+        }
+
+        nosimd::common::convertSfs(pSrc, pDst, tail, mode, scaleFactor);
+    }
+
+    template <typename _D>
+    INLINE void convertSfs(const float * pSrc, _D * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        switch (mode)
+        {
+            case simd::RoundMode::Near:
+                convertSat<_D, _MM_FROUND_TO_NEAREST_INT>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Zero:
+                convertSat<_D, _MM_FROUND_TO_ZERO>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Down:
+                convertSat<_D, _MM_FROUND_TO_NEG_INF>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+            case simd::RoundMode::Up:
+                convertSat<_D, _MM_FROUND_TO_POS_INF>(pSrc, pDst, len, mode, scaleFactor);
+                break;
+        }
+    }
+}
+
+namespace common
+{
+    // float, double <-> 32 bit; SSE4.1 has no 64-bit integer <-> float instruction
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, double * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, int32_t * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const double * pSrc, float * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const double * pSrc, int32_t * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int32_t * pSrc, float * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int32_t * pSrc, double * pDst, int len)
+    {
+        internals::convert(pSrc, pDst, len);
+    }
+
+    // 8, 16, 32 bit integers
+
+    _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int16_t * pDst, int len)
+    {
+        internals::widen<int8_t, int16_t, _mm_cvtepi8_epi16>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int32_t * pDst, int len)
+    {
+        internals::widen<int8_t, int32_t, _mm_cvtepi8_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int8_t * pSrc, int64_t * pDst, int len)
+    {
+        internals::widen<int8_t, int64_t, _mm_cvtepi8_epi64>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint16_t * pDst, int len)
+    {
+        internals::widen<uint8_t, uint16_t, _mm_cvtepu8_epi16>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint32_t * pDst, int len)
+    {
+        internals::widen<uint8_t, uint32_t, _mm_cvtepu8_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, uint64_t * pDst, int len)
+    {
+        internals::widen<uint8_t, uint64_t, _mm_cvtepu8_epi64>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int8_t * pDst, int len)
+    {
+        internals::narrow<int16_t, int8_t, _mm_packus_epi16>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int32_t * pDst, int len)
+    {
+        internals::widen<int16_t, int32_t, _mm_cvtepi16_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int16_t * pSrc, int64_t * pDst, int len)
+    {
+        internals::widen<int16_t, int64_t, _mm_cvtepi16_epi64>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint8_t * pDst, int len)
+    {
+        internals::narrow<uint16_t, uint8_t, _mm_packus_epi16>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint32_t * pDst, int len)
+    {
+        internals::widen<uint16_t, uint32_t, _mm_cvtepu16_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, uint64_t * pDst, int len)
+    {
+        internals::widen<uint16_t, uint64_t, _mm_cvtepu16_epi64>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int32_t * pSrc, int16_t * pDst, int len)
+    {
+        internals::narrow<int32_t, int16_t, _mm_packus_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int32_t * pSrc, int64_t * pDst, int len)
+    {
+        internals::widen<int32_t, int64_t, _mm_cvtepi32_epi64>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint32_t * pSrc, uint16_t * pDst, int len)
+    {
+        internals::narrow<uint32_t, uint16_t, _mm_packus_epi32>(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint32_t * pSrc, uint64_t * pDst, int len)
+    {
+        internals::widen<uint32_t, uint64_t, _mm_cvtepu32_epi64>(pSrc, pDst, len);
+    }
+
+    // 8, 16 bit <-> float
+
+    _SIMD_SSE_SPEC void convert(const int8_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<int8_t, _mm_cvtepi8_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, int8_t * pDst, int len)
+    {
+        internals::fromFloat<int8_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint8_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<uint8_t, _mm_cvtepu8_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, uint8_t * pDst, int len)
+    {
+        internals::fromFloat<uint8_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const int16_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<int16_t, _mm_cvtepi16_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, int16_t * pDst, int len)
+    {
+        internals::fromFloat<int16_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const uint16_t * pSrc, float * pDst, int len)
+    {
+        internals::toFloat<uint16_t, _mm_cvtepu16_epi32, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, uint16_t * pDst, int len)
+    {
+        internals::fromFloat<uint16_t, false>(pSrc, pDst, len, 1, 0);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const int8_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<int8_t, _mm_cvtepi8_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, int8_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<int8_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const uint8_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<uint8_t, _mm_cvtepu8_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, uint8_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<uint8_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const int16_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<int16_t, _mm_cvtepi16_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, int16_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<int16_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const uint16_t * pSrc, float * pDst, int len, float scale, float offset)
+    {
+        internals::toFloat<uint16_t, _mm_cvtepu16_epi32, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    _SIMD_SSE_SPEC void convertScale(const float * pSrc, uint16_t * pDst, int len, float scale, float offset)
+    {
+        internals::fromFloat<uint16_t, true>(pSrc, pDst, len, scale, offset);
+    }
+
+    // float -> 8, 16, 32 bit, rounded and saturated
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int8_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, uint8_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int16_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, uint16_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void convertSfs(const float * pSrc, int32_t * pDst, int len, simd::RoundMode mode, int scaleFactor)
+    {
+        internals::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+    }
+}
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include <smmintrin.h>
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+#include "sse.h"
+#include "sse-float.h"
+
+namespace sse
+{
+namespace internals
+{
+#if !defined(__F16C__)
+    /// Halves in the low 16 bits of 32-bit lanes to float, as float16_t::toFloat(): subnormals through a
+    /// multiply by 2^112, inf and NaN get the full exponent
+    INLINE __m128 half_to_ps(__m128i h)
+    {
+        __m128i expmant = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+        __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, expmant), 16);
+        __m128 scaled = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(expmant, 13)),
+                                   _mm_castsi128_ps(_mm_set1_epi32((254 - 15) << 23)));
+        __m128i infnan = _mm_cmpgt_epi32(expmant, _mm_set1_epi32(0x7bff));
+        __m128 exp = _mm_and_ps(_mm_castsi128_ps(infnan), _mm_castsi128_ps(_mm_set1_epi32(0x7f800000)));
+        return _mm_or_ps(_mm_or_ps(scaled, exp), _mm_castsi128_ps(sign));
+    }
+
+    /// Float to halves in the low 16 bits of 32-bit lanes, as float16_t::fromFloat()
+    INLINE __m128i ps_to_half(__m128 f)
+    {
+        __m128i x = _mm_castps_si128(f);
+        __m128i absx = _mm_and_si128(x, _mm_set1_epi32(0x7fffffff));
+        __m128i sign = _mm_srli_epi32(_mm_xor_si128(x, absx), 16);
+
+        __m128 sub = _mm_add_ps(_mm_castsi128_ps(absx), _mm_set1_ps(0.5f));
+        __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(sub), _mm_set1_epi32(0x3f000000));
+
+        __m128i odd = _mm_and_si128(_mm_srli_epi32(absx, 13), _mm_set1_epi32(1));
+        __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(absx, _mm_set1_epi32(0xc8000fff)), odd), 13);
+
+        __m128i payload = _mm_and_si128(_mm_srli_epi32(absx, 13), _mm_set1_epi32(0x3ff));
+        __m128i nan = _mm_or_si128(_mm_set1_epi32(0x7e00), payload);
+        __m128i special = _mm_blendv_epi8(_mm_set1_epi32(0x7c00), nan, _mm_cmpgt_epi32(absx, _mm_set1_epi32(0x7f800000)));
+
+        __m128i r = _mm_blendv_epi8(normal, subnormal, _mm_cmplt_epi32(absx, _mm_set1_epi32(0x38800000)));
+        r = _mm_blendv_epi8(r, special, _mm_cmpgt_epi32(absx, _mm_set1_epi32(0x477fefff)));
+        return _mm_or_si128(r, sign);
+    }
+#endif
+
+    /// Four 16-bit floats in the low 64 bits to float and back
+    template <typename _H> struct Half;
+
+    template <> struct Half<simd::float16_t>
+    {
+#if defined(__F16C__)
+        static INLINE __m128 toFloat(__m128i h) { return _mm_cvtph_ps(h); }
+        static INLINE __m128i fromFloat(__m128 f) { return _mm_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT); }
+#else
+        static INLINE __m128 toFloat(__m128i h) { return half_to_ps(_mm_cvtepu16_epi32(h)); }
+
+        static INLINE __m128i fromFloat(__m128 f)
+        {
+            __m128i h = ps_to_half(f);
+            return _mm_packus_epi32(h, h);
+        }
+#endif
+    };
+
+    template <> struct Half<simd::bfloat16_t>
+    {
+        static INLINE __m128 toFloat(__m128i h) { return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), h)); }
+
+        static INLINE __m128i fromFloat(__m128 f)
+        {
+            __m128i x = _mm_castps_si128(f);
+            __m128i odd = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+            __m128i r = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(0x7fff)), odd), 16);
+            __m128i nan = _mm_or_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(0x40));
+            r = _mm_blendv_epi8(r, nan, _mm_castps_si128(_mm_cmpunord_ps(f, f)));
+            return _mm_packus_epi32(r, r);
+        }
+    };
+
+    template <typename _H>
+    INLINE void halfToFloat(const _H * pSrc, float * pDst, int len)
+    {
+        int tail = len % 8;
+        const _H * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 8, pDst += 8)
+        {
+            __m128i h = sse_load_si((const __m128i*)pSrc);
+            sse_store_ps(pDst, Half<_H>::toFloat(h));
+            sse_store_ps(pDst + 4, Half<_H>::toFloat(_mm_unpackhi_epi64(h, h)));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = pSrc[i];
+    }
+
+    template <typename _H>
+    INLINE void floatToHalf(const float * pSrc, _H * pDst, int len)
+    {
+        int tail = len % 8;
+        const float * pEnd = pSrc + (len-tail);
+
+        for (; pSrc < pEnd; pSrc += 8, pDst += 8)
+        {
+            __m128i a = Half<_H>::fromFloat(sse_load_ps(pSrc));
+            __m128i b = Half<_H>::fromFloat(sse_load_ps(pSrc + 4));
+            sse_store_si((__m128i*)pDst, _mm_unpacklo_epi64(a, b));
+        }
+
+        for (int i = 0; i < tail; ++i)
+            pDst[i] = pSrc[i];
+    }
+
+    /// Two float accumulators, as sum and dotProd_v1 for float
+    template <typename _H>
+    INLINE void sumHalf(const _H * pSrc, int len, float * pSum)
+    {
+        int tail = len % 8;
+        const _H * pEnd = pSrc + (len-tail);
+        __m128 r0 = _mm_setzero_ps();
+        __m128 r1 = _mm_setzero_ps();
+
+        for (; pSrc < pEnd; pSrc += 8)
+        {
+            __m128i h = sse_load_si((const __m128i*)pSrc);
+            r0 = _mm_add_ps(r0, Half<_H>::toFloat(h));
+            r1 = _mm_add_ps(r1, Half<_H>::toFloat(_mm_unpackhi_epi64(h, h)));
+        }
+
+        float sum = _mm_cvtss_f32(horizontal_sum(_mm_add_ps(r0, r1)));
+        for (int i = 0; i < tail; ++i)
+            sum += pSrc[i];
+        *pSum = sum;
+    }
+
+    template <typename _H>
+    INLINE void dotProdHalf(const _H * pSrc1, const _H * pSrc2, int len, float * pDp)
+    {
+        int tail = len % 8;
+        const _H * pEnd = pSrc1 + (len-tail);
+        __m128 r0 = _mm_setzero_ps();
+        __m128 r1 = _mm_setzero_ps();
+
+        for (; pSrc1 < pEnd; pSrc1 += 8, pSrc2 += 8)
+        {
+            __m128i a = sse_load_si((const __m128i*)pSrc1);
+            __m128i b = sse_load_si((const __m128i*)pSrc2);
+            r0 = _mm_add_ps(r0, _mm_mul_ps(Half<_H>::toFloat(a), Half<_H>::toFloat(b)));
+            r1 = _mm_add_ps(r1, _mm_mul_ps(Half<_H>::toFloat(_mm_unpackhi_epi64(a, a)),
+                                           Half<_H>::toFloat(_mm_unpackhi_epi64(b, b))));
+        }
+
+        float dp = _mm_cvtss_f32(horizontal_sum(_mm_add_ps(r0, r1)));
+        for (int i = 0; i < tail; ++i)
+            dp += float(pSrc1[i]) * float(pSrc2[i]);
+        *pDp = dp;
+    }
+}
+
+namespace common
+{
+    _SIMD_SSE_SPEC void convert(const simd::float16_t * pSrc, float * pDst, int len)
+    {
+        internals::halfToFloat(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, simd::float16_t * pDst, int len)
+    {
+        internals::floatToHalf(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const simd::bfloat16_t * pSrc, float * pDst, int len)
+    {
+        internals::halfToFloat(pSrc, pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void convert(const float * pSrc, simd::bfloat16_t * pDst, int len)
+    {
+        internals::floatToHalf(pSrc, pDst, len);
+    }
+}
+
+namespace statistical
+{
+    // 16-bit float storage, float accumulators
+
+    INLINE void sum(const simd::float16_t * pSrc, int len, float * pSum)
+    {
+        internals::sumHalf(pSrc, len, pSum);
+    }
+
+    INLINE void sum(const simd::bfloat16_t * pSrc, int len, float * pSum)
+    {
+        internals::sumHalf(pSrc, len, pSum);
+    }
+
+    INLINE void dotProd(const simd::float16_t * pSrc1, const simd::float16_t * pSrc2, int len, float * pDp)
+    {
+        internals::dotProdHalf(pSrc1, pSrc2, len, pDp);
+    }
+
+    INLINE void dotProd(const simd::bfloat16_t * pSrc1, const simd::bfloat16_t * pSrc2, int len, float * pDp)
+    {
+        internals::dotProdHalf(pSrc1, pSrc2, len, pDp);
+    }
+}
+}
@@ -122,6 +122,245 @@ namespace internals
             store(pDst, op(load(pSrc1), load(pSrc2)));
         }
     }
+
+    // Multiplies without a native instruction
+
+    /// Low 8 bits of 8-bit products: 16-bit products of the even and of the odd bytes
+    INLINE __m128i mullo_epi8(__m128i a, __m128i b)
+    {
+        __m128i even = _mm_mullo_epi16(a, b);
+        __m128i odd = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+        return _mm_or_si128(_mm_slli_epi16(odd, 8), _mm_and_si128(even, _mm_set1_epi16(0xff)));
+    }
+
+    /// Low 64 bits of 64-bit products: lo*lo + ((hi*lo + lo*hi) << 32)
+    INLINE __m128i mullo_epi64(__m128i a, __m128i b)
+    {
+        __m128i lo = _mm_mul_epu32(a, b);
+        __m128i cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b), _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+        return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));
+    }
+
+    // Saturating ops. 8 and 16-bit add and sub are native.
+
+    INLINE __m128i sat_epi32(__m128i sign)
+    {
+        return _mm_xor_si128(_mm_srai_epi32(sign, 31), _mm_set1_epi32(0x7fffffff));
+    }
+
+    INLINE __m128i adds_epi32(__m128i a, __m128i b)
+    {
+        __m128i s = _mm_add_epi32(a, b);
+        __m128i over = _mm_and_si128(_mm_xor_si128(a, s), _mm_xor_si128(b, s));
+        return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(s), _mm_castsi128_ps(sat_epi32(a)), _mm_castsi128_ps(over)));
+    }
+
+    INLINE __m128i subs_epi32(__m128i a, __m128i b)
+    {
+        __m128i d = _mm_sub_epi32(a, b);
+        __m128i over = _mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, d));
+        return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(d), _mm_castsi128_ps(sat_epi32(a)), _mm_castsi128_ps(over)));
+    }
+
+    INLINE __m128i adds_epu32(__m128i a, __m128i b)
+    {
+        return _mm_add_epi32(a, _mm_min_epu32(b, _mm_xor_si128(a, _mm_set1_epi32(-1))));
+    }
+
+    INLINE __m128i subs_epu32(__m128i a, __m128i b)
+    {
+        return _mm_sub_epi32(_mm_max_epu32(a, b), b);
+    }
+
+    /// Low and high halves of the 64-bit products of 32-bit lanes
+    template <IntrI::Binary mul>
+    INLINE __m128i mul_wide_epi32(__m128i a, __m128i b, __m128i& hi)
+    {
+        __m128i even = mul(a, b);
+        __m128i odd = mul(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        hi = _mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xcc);
+        return _mm_blend_epi16(even, _mm_slli_epi64(odd, 32), 0xcc);
+    }
+
+    INLINE __m128i muls_epi32(__m128i a, __m128i b)
+    {
+        __m128i hi;
+        __m128i lo = mul_wide_epi32<_mm_mul_epi32>(a, b, hi);
+        __m128i fits = _mm_cmpeq_epi32(hi, _mm_srai_epi32(lo, 31));
+        return _mm_blendv_epi8(sat_epi32(_mm_xor_si128(a, b)), lo, fits);
+    }
+
+    INLINE __m128i muls_epu32(__m128i a, __m128i b)
+    {
+        __m128i hi;
+        __m128i lo = mul_wide_epi32<_mm_mul_epu32>(a, b, hi);
+        return _mm_or_si128(lo, _mm_xor_si128(_mm_cmpeq_epi32(hi, _mm_setzero_si128()), _mm_set1_epi32(-1)));
+    }
+
+    INLINE __m128i muls_epi16(__m128i a, __m128i b)
+    {
+        __m128i lo = _mm_mullo_epi16(a, b);
+        __m128i hi = _mm_mulhi_epi16(a, b);
+        return _mm_packs_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpackhi_epi16(lo, hi));
+    }
+
+    INLINE __m128i muls_epu16(__m128i a, __m128i b)
+    {
+        __m128i lo = _mm_mullo_epi16(a, b);
+        __m128i hi = _mm_mulhi_epu16(a, b);
+        __m128i max = _mm_set1_epi32(0xffff);
+        return _mm_packus_epi32(_mm_min_epu32(_mm_unpacklo_epi16(lo, hi), max),
+                                _mm_min_epu32(_mm_unpackhi_epi16(lo, hi), max));
+    }
+
+    INLINE __m128i muls_epi8(__m128i a, __m128i b)
+    {
+        __m128i lo = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpacklo_epi8(a, a), 8), _mm_srai_epi16(_mm_unpacklo_epi8(b, b), 8));
+        __m128i hi = _mm_mullo_epi16(_mm_srai_epi16(_mm_unpackhi_epi8(a, a), 8), _mm_srai_epi16(_mm_unpackhi_epi8(b, b), 8));
+        return _mm_packs_epi16(lo, hi);
+    }
+
+    INLINE __m128i muls_epu8(__m128i a, __m128i b)
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i max = _mm_set1_epi16(0xff);
+        __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        return _mm_packus_epi16(_mm_min_epu16(lo, max), _mm_min_epu16(hi, max));
+    }
+
+    /// Scaled forms of 8 and 16-bit items: 4 items widened to 32-bit lanes, the shift of their exact result
+    /// and the saturating narrowing to _T
+    template <typename _T> struct SatI;
+
+    template <> struct SatI<int16_t>
+    {
+        static INLINE __m128i widen(const int16_t * p) { return _mm_cvtepi16_epi32(sse_load_low<8>(p)); }
+        static INLINE __m128i shift(__m128i x, __m128i count) { return _mm_sra_epi32(x, count); }
+        static INLINE __m128i pack32(__m128i a, __m128i b) { return _mm_packs_epi32(a, b); }
+    };
+
+    template <> struct SatI<uint16_t>
+    {
+        static INLINE __m128i widen(const uint16_t * p) { return _mm_cvtepu16_epi32(sse_load_low<8>(p)); }
+        static INLINE __m128i shift(__m128i x, __m128i count) { return _mm_srl_epi32(x, count); }
+
+        static INLINE __m128i pack32(__m128i a, __m128i b)
+        {
+            __m128i max = _mm_set1_epi32(0xffff);
+            return _mm_packus_epi32(_mm_min_epu32(a, max), _mm_min_epu32(b, max));
+        }
+    };
+
+    template <> struct SatI<int8_t>
+    {
+        static INLINE __m128i widen(const int8_t * p) { return _mm_cvtepi8_epi32(sse_load_low<4>(p)); }
+        static INLINE __m128i shift(__m128i x, __m128i count) { return _mm_sra_epi32(x, count); }
+        static INLINE __m128i pack32(__m128i a, __m128i b) { return _mm_packs_epi32(a, b); }
+        static INLINE __m128i pack16(__m128i a, __m128i b) { return _mm_packs_epi16(a, b); }
+    };
+
+    template <> struct SatI<uint8_t>
+    {
+        static INLINE __m128i widen(const uint8_t * p) { return _mm_cvtepu8_epi32(sse_load_low<4>(p)); }
+        static INLINE __m128i shift(__m128i x, __m128i count) { return _mm_srl_epi32(x, count); }
+
+        static INLINE __m128i pack32(__m128i a, __m128i b)
+        {
+            __m128i max = _mm_set1_epi32(0xff);
+            return _mm_packus_epi32(_mm_min_epu32(a, max), _mm_min_epu32(b, max));
+        }
+
+        static INLINE __m128i pack16(__m128i a, __m128i b) { return _mm_packus_epi16(a, b); }
+    };
+
+    /// Right shift by 1..30 rounding half to even
+    struct ScaleI
+    {
+        __m128i count;
+        __m128i mask;
+        __m128i half;
+
+        explicit ScaleI(int sf)
+        :   count(_mm_cvtsi32_si128(sf)), mask(_mm_set1_epi32((1 << sf) - 1)), half(_mm_set1_epi32(1 << (sf - 1)))
+        {}
+    };
+
+    template <typename _T, IntrI::Binary op32>
+    INLINE __m128i scaledLanes(const _T * pSrc1, const _T * pSrc2, const ScaleI& s)
+    {
+        __m128i x = op32(SatI<_T>::widen(pSrc1), SatI<_T>::widen(pSrc2));
+        __m128i q = SatI<_T>::shift(x, s.count);
+        __m128i r = _mm_add_epi32(_mm_and_si128(x, s.mask), _mm_and_si128(q, _mm_set1_epi32(1)));
+        return _mm_sub_epi32(q, _mm_cmpgt_epi32(r, s.half));
+    }
+
+    template <typename _T, IntrI::Binary op32>
+    INLINE __m128i scaledBlock(const _T * pSrc1, const _T * pSrc2, const ScaleI& s, std::integral_constant<int, 2>)
+    {
+        return SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1, pSrc2, s), scaledLanes<_T, op32>(pSrc1 + 4, pSrc2 + 4, s));
+    }
+
+    template <typename _T, IntrI::Binary op32>
+    INLINE __m128i scaledBlock(const _T * pSrc1, const _T * pSrc2, const ScaleI& s, std::integral_constant<int, 1>)
+    {
+        __m128i lo = SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1, pSrc2, s), scaledLanes<_T, op32>(pSrc1 + 4, pSrc2 + 4, s));
+        __m128i hi = SatI<_T>::pack32(scaledLanes<_T, op32>(pSrc1 + 8, pSrc2 + 8, s),
+                                      scaledLanes<_T, op32>(pSrc1 + 12, pSrc2 + 12, s));
+        return SatI<_T>::pack16(lo, hi);
+    }
+
+    template <typename _T>
+    using SatScalar = void (*)(const _T *, const _T *, _T *, int, int);
+
+    /// Without scaling: sat on whole registers, scalar tail
+    template <typename _T, IntrI::Binary sat, SatScalar<_T> scalar>
+    INLINE void satPtrPtrDst(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len)
+    {
+        const int step = 16 / sizeof(_T);
+        int tail = len % step;
+        len -= tail;
+        iPtrPtrDst<sat>((const __m128i*)pSrc1, (const __m128i*)pSrc2, (__m128i*)pDst, len / step);
+        scalar(pSrc1 + len, pSrc2 + len, pDst + len, tail, 0);
+    }
+
+    /// 32-bit items: scaled results stay scalar
+    template <typename _T, IntrI::Binary sat, SatScalar<_T> scalar>
+    INLINE void satSfs32(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+    {
+        if (scaleFactor == 0)
+            satPtrPtrDst<_T, sat, scalar>(pSrc1, pSrc2, pDst, len);
+        else
+        {
+            _SIMD_FALLBACK(len);
+            scalar(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+    }
+
+    /// 8 and 16-bit items: op32 on widened items for a scaleFactor in 1..30, scalar for other ones
+    template <typename _T, IntrI::Binary sat, IntrI::Binary op32, SatScalar<_T> scalar>
+    INLINE void satSfs(const _T * pSrc1, const _T * pSrc2, _T * pDst, int len, int scaleFactor)
+    {
+        if (scaleFactor == 0)
+            satPtrPtrDst<_T, sat, scalar>(pSrc1, pSrc2, pDst, len);
+        else if (scaleFactor > 0 && scaleFactor <= 30)
+        {
+            const int step = 16 / sizeof(_T);
+            int tail = len % step;
+            len -= tail;
+
+            ScaleI s(scaleFactor);
+            for (int i = 0; i < len; i += step)
+                sse_store_si((__m128i*)(pDst + i), scaledBlock<_T, op32>(pSrc1 + i, pSrc2 + i, s,
+                                                                         std::integral_constant<int, sizeof(_T)>()));
+            scalar(pSrc1 + len, pSrc2 + len, pDst + len, tail, scaleFactor);
+        }
+        else
+        {
+            _SIMD_FALLBACK(len);
+            scalar(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+    }
 }
 
 namespace common
@@ -207,11 +446,13 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const int32_t * pSrc, int32_t val, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -239,6 +480,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -277,11 +519,13 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void divC(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint32_t * pSrc, uint32_t val, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -307,6 +551,7 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void div(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -341,16 +586,20 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        internals::iPtrValDst<internals::mullo_epi64>((const __m128i*)pSrc, _mm_set1_epi64x(val), (__m128i*)pDst, (len>>1));
+        if (len & 1)
+            pDst[len-1] = pSrc[len-1] * val;
     }
 
     _SIMD_SSE_SPEC void divC(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const int64_t * pSrc, int64_t val, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -371,16 +620,20 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        internals::iPtrPtrDst<internals::mullo_epi64>((const __m128i*)pSrc1, (const __m128i*)pSrc2, (__m128i*)pDst, (len>>1));
+        if (len & 1)
+            pDst[len-1] = pSrc1[len-1] * pSrc2[len-1];
     }
 
     _SIMD_SSE_SPEC void div(const int64_t * pSrc1, const int64_t * pSrc2, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
     _SIMD_SSE_SPEC void abs(const int64_t * pSrc, int64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::abs(pSrc, pDst, len);
     }
 
@@ -403,16 +656,18 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mulC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
-        nosimd::arithmetic::mulC(pSrc, val, pDst, len);
+        mulC((const int64_t*)pSrc, (int64_t)val, (int64_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void divC(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divC(pSrc, val, pDst, len);
     }
 
     _SIMD_SSE_SPEC void divCRev(const uint64_t * pSrc, uint64_t val, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::divCRev(pSrc, val, pDst, len);
     }
 
@@ -429,11 +684,12 @@ namespace arithmetic
 
     _SIMD_SSE_SPEC void mul(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
     {
-        nosimd::arithmetic::mul(pSrc1, pSrc2, pDst, len);
+        mul((const int64_t*)pSrc1, (const int64_t*)pSrc2, (int64_t*)pDst, len);
     }
 
     _SIMD_SSE_SPEC void div(const uint64_t * pSrc1, const uint64_t * pSrc2, uint64_t * pDst, int len)
     {
+        _SIMD_FALLBACK(len);
         nosimd::arithmetic::div(pSrc1, pSrc2, pDst, len);
     }
 
@@ -442,6 +698,142 @@ namespace arithmetic
         if (pSrc != pDst)
             copy(pSrc, pDst, len);
     }
+
+    //
+
+    _SIMD_SSE_SPEC void mulC(const int8_t * pSrc, int8_t val, int8_t * pDst, int len)
+    {
+        internals::iPtrValDst<internals::mullo_epi8>((const __m128i*)pSrc, _mm_set1_epi8(val), (__m128i*)pDst, (len>>4));
+        for (int i = len - (len & 0xf); i < len; ++i)
+            pDst[i] = pSrc[i] * val;
+    }
+
+    _SIMD_SSE_SPEC void mul(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len)
+    {
+        internals::iPtrPtrDst<internals::mullo_epi8>((const __m128i*)pSrc1, (const __m128i*)pSrc2, (__m128i*)pDst, (len>>4));
+        for (int i = len - (len & 0xf); i < len; ++i)
+            pDst[i] = pSrc1[i] * pSrc2[i];
+    }
+
+    _SIMD_SSE_SPEC void mulC(const uint8_t * pSrc, uint8_t val, uint8_t * pDst, int len)
+    {
+        mulC((const int8_t*)pSrc, (int8_t)val, (int8_t*)pDst, len);
+    }
+
+    _SIMD_SSE_SPEC void mul(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len)
+    {
+        mul((const int8_t*)pSrc1, (const int8_t*)pSrc2, (int8_t*)pDst, len);
+    }
+
+    // saturating, scaled by 2^-scaleFactor
+
+    _SIMD_SSE_SPEC void addSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, _mm_adds_epi8, _mm_add_epi32, nosimd::arithmetic::addSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, _mm_subs_epi8, _mm_sub_epi32, nosimd::arithmetic::subSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int8_t, internals::muls_epi8, _mm_mullo_epi32, nosimd::arithmetic::mulSfs<int8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, _mm_adds_epu8, _mm_add_epi32, nosimd::arithmetic::addSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, _mm_subs_epu8, internals::subs_epu32, nosimd::arithmetic::subSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint8_t, internals::muls_epu8, _mm_mullo_epi32, nosimd::arithmetic::mulSfs<uint8_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, _mm_adds_epi16, _mm_add_epi32, nosimd::arithmetic::addSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, _mm_subs_epi16, _mm_sub_epi32, nosimd::arithmetic::subSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<int16_t, internals::muls_epi16, _mm_mullo_epi32, nosimd::arithmetic::mulSfs<int16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, _mm_adds_epu16, _mm_add_epi32, nosimd::arithmetic::addSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, _mm_subs_epu16, internals::subs_epu32, nosimd::arithmetic::subSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs<uint16_t, internals::muls_epu16, _mm_mullo_epi32, nosimd::arithmetic::mulSfs<uint16_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::adds_epi32, nosimd::arithmetic::addSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::subs_epi32, nosimd::arithmetic::subSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<int32_t, internals::muls_epi32, nosimd::arithmetic::mulSfs<int32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void addSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::adds_epu32, nosimd::arithmetic::addSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void subSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::subs_epu32, nosimd::arithmetic::subSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
+
+    _SIMD_SSE_SPEC void mulSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor)
+    {
+        internals::satSfs32<uint32_t, internals::muls_epu32, nosimd::arithmetic::mulSfs<uint32_t>>(
+            pSrc1, pSrc2, pDst, len, scaleFactor);
+    }
 }
 
 // TODO
@@ -449,31 +841,37 @@ namespace statistical
 {
     _SIMD_SSE_T void min(const _T * pSrc, int len, _T * pMin)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::min(pSrc, len, pMin);
     }
 
     _SIMD_SSE_T void max(const _T * pSrc, int len, _T * pMax)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::max(pSrc, len, pMax);
     }
 
     _SIMD_SSE_T void minMax(const _T * pSrc, int len, _T * pMin, _T * pMax)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::minMax(pSrc, len, pMin, pMax);
     }
 
     _SIMD_SSE_T void sum(const _T * pSrc, int len, _T * pSum)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::sum(pSrc, len, pSum);
     }
 
     _SIMD_SSE_T void meanStdDev(const _T * pSrc, int len, _T * pMean, _T * pStdDev)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::meanStdDev(pSrc, len, pMean, pStdDev);
     }
 
     _SIMD_SSE_T void dotProd(const _T * pSrc1, const _T * pSrc2, int len, _T * pDp)
     {
+        _SIMD_FALLBACK(len);
         return nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
+#include <cstring>
+
 #include "nosimd.h"
+#include "fallback.h"
 
 #ifdef max
 #undef max
@@ -58,6 +61,26 @@ namespace sse
     INLINE void sse_store_si(__m128i * x, __m128i y) { _mm_storeu_si128(x, y); }
 #endif
 
+    /// Loads _Bytes from x into the low part of a register, no alignment needed
+    template <int _Bytes> INLINE __m128i sse_load_low(const void * x);
+
+    template <> INLINE __m128i sse_load_low<16>(const void * x) { return _mm_loadu_si128((const __m128i *)x); }
+    template <> INLINE __m128i sse_load_low<8>(const void * x) { return _mm_loadl_epi64((const __m128i *)x); }
+
+    template <> INLINE __m128i sse_load_low<4>(const void * x)
+    {
+        int32_t v;
+        memcpy(&v, x, sizeof(v));
+        return _mm_cvtsi32_si128(v);
+    }
+
+    template <> INLINE __m128i sse_load_low<2>(const void * x)
+    {
+        uint16_t v;
+        memcpy(&v, x, sizeof(v));
+        return _mm_cvtsi32_si128(v);
+    }
+
 #ifdef SIMD_AVX
     using IntrAvxS = Intrinsic<__m256, float>;
     using IntrAvxD = Intrinsic<__m256d, double>;
@@ -145,11 +168,13 @@ namespace sse
     {
         _SIMD_SSE_T void set(_T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::common::set(val, pDst, len);
         }
 
         _SIMD_SSE_T void copy(const _T* pSrc, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::common::copy(pSrc, pDst, len);
         }
 
@@ -175,87 +200,158 @@ namespace sse
 
         _SIMD_SSE_TU void convert(const _T * pSrc, _U * pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::common::convert(pSrc, pDst, len);
         }
 
-#if 0 // TODO
-        _SIMD_SSE_T void move(const _T * pSrc, _T * pDst, int len);
-#else
-        using nosimd::common::move;
-#endif
+        _SIMD_SSE_TU void convertScale(const _T * pSrc, _U * pDst, int len, float scale, float offset)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::common::convertScale(pSrc, pDst, len, scale, offset);
+        }
+
+        _SIMD_SSE_TU void convertSfs(const _T * pSrc, _U * pDst, int len, simd::RoundMode mode, int scaleFactor)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::common::convertSfs(pSrc, pDst, len, mode, scaleFactor);
+        }
+
+        // TODO
+        _SIMD_SSE_T void move(const _T * pSrc, _T * pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::common::move(pSrc, pDst, len);
+        }
     }
 
     namespace compare
     {
-#if 0 // TODO
-        _SIMD_SSE_T void find(_T * pSrc, _T val, int len, int * pPosition);
-        _SIMD_SSE_T void findNot(_T * pSrc, _T val, int len, int * pPosition);
-        _SIMD_SSE_T void findSame(const _T * pSrc1, _T * pSrc2, int len, int * pPosition);
-        _SIMD_SSE_T void findDiff(const _T * pSrc1, _T * pSrc2, int len, int * pPosition);
-#else
-        using nosimd::compare::find;
-        using nosimd::compare::findNot;
-        using nosimd::compare::findSame;
-        using nosimd::compare::findDiff;
-#endif
+        // TODO
+        _SIMD_SSE_T void find(_T * pSrc, _T val, int len, int * pPosition)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::compare::find(pSrc, val, len, pPosition);
+        }
+
+        _SIMD_SSE_T void findNot(_T * pSrc, _T val, int len, int * pPosition)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::compare::findNot(pSrc, val, len, pPosition);
+        }
+
+        _SIMD_SSE_T void findSame(const _T * pSrc1, _T * pSrc2, int len, int * pPosition)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::compare::findSame(pSrc1, pSrc2, len, pPosition);
+        }
+
+        _SIMD_SSE_T void findDiff(const _T * pSrc1, _T * pSrc2, int len, int * pPosition)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::compare::findDiff(pSrc1, pSrc2, len, pPosition);
+        }
     }
 
     namespace arithmetic
     {
         _SIMD_SSE_T void addC(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::addC(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void add(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::add(pSrc1, pSrc2, pDst, len);
         }
 
         _SIMD_SSE_T void subC(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::subC(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void subCRev(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::subCRev(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void sub(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::sub(pSrc1, pSrc2, pDst, len);
         }
 
         _SIMD_SSE_T void mulC(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::mulC(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void mul(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::mul(pSrc1, pSrc2, pDst, len);
         }
 
         _SIMD_SSE_T void divC(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::divC(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void divCRev(const _T* pSrc, _T val, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::divCRev(pSrc, val, pDst, len);
         }
 
         _SIMD_SSE_T void div(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::div(pSrc1, pSrc2, pDst, len);
         }
 
         _SIMD_SSE_T void abs(const _T* pSrc, _T* pDst, int len)
         {
+            _SIMD_FALLBACK(len);
             nosimd::abs(pSrc, pDst, len);
         }
+
+        _SIMD_SSE_T void addSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::addSfs(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+
+        _SIMD_SSE_T void subSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::subSfs(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+
+        _SIMD_SSE_T void mulSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::mulSfs(pSrc1, pSrc2, pDst, len, scaleFactor);
+        }
+
+        _SIMD_SSE_T void addSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            addSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
+
+        _SIMD_SSE_T void subSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            subSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
+
+        _SIMD_SSE_T void mulSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            mulSfs(pSrc1, pSrc2, pDst, len, 0);
+        }
     }
 
     namespace power
@@ -264,10 +360,29 @@ namespace sse
         _SIMD_SSE_T void sqrt(const _T* pSrc, _T* pDst, int len);
         _SIMD_SSE_T void invSqrt(const _T* pSrc, _T* pDst, int len);
 
-        using nosimd::power::powx;
-        using nosimd::power::pow;
-        using nosimd::power::cbrt;
-        using nosimd::power::hypot;
+        _SIMD_SSE_T void powx(const _T* pSrc, const _T constValue, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::power::powx(pSrc, constValue, pDst, len);
+        }
+
+        _SIMD_SSE_T void pow(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::power::pow(pSrc1, pSrc2, pDst, len);
+        }
+
+        _SIMD_SSE_T void cbrt(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::power::cbrt(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void hypot(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::power::hypot(pSrc1, pSrc2, pDst, len);
+        }
     }
 
     namespace statistical
@@ -276,15 +391,24 @@ namespace sse
         _SIMD_SSE_T void max(const _T* pSrc, int len, _T* pMax);
         _SIMD_SSE_T void minMax(const _T* pSrc, int len, _T* pMin, _T* pMax);
 
-#if 0 // TODO
-        _SIMD_SSE_T void minIndx(const _T * pSrc, int len, _T * pMin, int * pIndx);
-        _SIMD_SSE_T void maxIndx(const _T * pSrc, int len, _T * pMax, int * pIndx);
-        _SIMD_SSE_T void minMaxIndx(const _T * pSrc, int len, _T * pMin, int * pMinIndx, _T * pMax, int * pMaxIndx);
-#else
-        using nosimd::statistical::minIndx;
-        using nosimd::statistical::maxIndx;
-        using nosimd::statistical::minMaxIndx;
-#endif
+        // TODO
+        _SIMD_SSE_T void minIndx(const _T * pSrc, int len, _T * pMin, int * pIndx)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::minIndx(pSrc, len, pMin, pIndx);
+        }
+
+        _SIMD_SSE_T void maxIndx(const _T * pSrc, int len, _T * pMax, int * pIndx)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::maxIndx(pSrc, len, pMax, pIndx);
+        }
+
+        _SIMD_SSE_T void minMaxIndx(const _T * pSrc, int len, _T * pMin, int * pMinIndx, _T * pMax, int * pMaxIndx)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::minMaxIndx(pSrc, len, pMin, pMinIndx, pMax, pMaxIndx);
+        }
 
         _SIMD_SSE_T void sum(const _T* pSrc, int len, _T* pSum);
         _SIMD_SSE_T void meanStdDev(const _T* pSrc, int len, _T* pMean, _T* pStdDev);
@@ -303,21 +427,98 @@ namespace sse
 
         _SIMD_SSE_T void dotProd(const _T* pSrc1, const _T* pSrc2, int len, _T* pDp);
 
-#if 0 // TODO
-        _SIMD_SSE_T void normInf(const _T* pSrc, int len, _T* pNorm);
-        _SIMD_SSE_T void normL1(const _T* pSrc, int len, _T* pNorm);
-        _SIMD_SSE_T void normL2(const _T* pSrc, int len, _T* pNorm);
-        _SIMD_SSE_T void normDiffInf(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
-        _SIMD_SSE_T void normDiffL1(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
-        _SIMD_SSE_T void normDiffL2(const _T* pSrc1, const _T* pSrc2, int len, _T* pNorm);
-#else
-        using nosimd::statistical::normInf;
-        using nosimd::statistical::normL1;
-        using nosimd::statistical::normL2;
-        using nosimd::statistical::normDiffInf;
-        using nosimd::statistical::normDiffL1;
-        using nosimd::statistical::normDiffL2;
-#endif
+        // TODO
+        _SIMD_SSE_TU void normInf(const _T* pSrc, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normInf(pSrc, len, pNorm);
+        }
+
+        _SIMD_SSE_TU void normL1(const _T* pSrc, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normL1(pSrc, len, pNorm);
+        }
+
+        _SIMD_SSE_TU void normL2(const _T* pSrc, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normL2(pSrc, len, pNorm);
+        }
+
+        _SIMD_SSE_TU void normDiffInf(const _T* pSrc1, const _T* pSrc2, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normDiffInf(pSrc1, pSrc2, len, pNorm);
+        }
+
+        _SIMD_SSE_TU void normDiffL1(const _T* pSrc1, const _T* pSrc2, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normDiffL1(pSrc1, pSrc2, len, pNorm);
+        }
+
+        _SIMD_SSE_TU void normDiffL2(const _T* pSrc1, const _T* pSrc2, int len, _U* pNorm)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::statistical::normDiffL2(pSrc1, pSrc2, len, pNorm);
+        }
+    }
+
+    // TODO
+    namespace exp_log
+    {
+        _SIMD_SSE_T void exp(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::exp_log::exp(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void ln(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::exp_log::ln(pSrc, pDst, len);
+        }
+    }
+
+    // TODO
+    namespace trigonometric
+    {
+        _SIMD_SSE_T void sin(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::sin(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void cos(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::cos(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void tan(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::tan(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void asin(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::asin(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void acos(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::acos(pSrc, pDst, len);
+        }
+
+        _SIMD_SSE_T void atan(const _T* pSrc, _T* pDst, int len)
+        {
+            _SIMD_FALLBACK(len);
+            nosimd::trigonometric::atan(pSrc, pDst, len);
+        }
     }
 
     using namespace sse::common;
@@ -325,7 +526,6 @@ namespace sse
     using namespace sse::arithmetic;
     using namespace sse::power;
     using namespace sse::statistical;
-
-    using namespace nosimd::exp_log;
-    using namespace nosimd::trigonometric;
+    using namespace sse::exp_log;
+    using namespace sse::trigonometric;
 }
@@ -305,6 +305,51 @@ namespace arithmetic
     {
         void abs(const double* pSrc, double* pDst, int len) { STATUS_CHECK(ippsAbs_64f_A53(pSrc, pDst, len)); }
     }
+
+    // addSfs
+    template <> void addSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsAdd_8u_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void addSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsAdd_16s_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void addSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsAdd_16u_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void addSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsAdd_32s_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    //
+    template <> void addSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::addSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
+    template <> void addSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::addSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
+
+    // subSfs (fixed parameters order)
+    template <> void subSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsSub_8u_Sfs(pSrc2, pSrc1, pDst, len, scaleFactor)); }
+    template <> void subSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsSub_16s_Sfs(pSrc2, pSrc1, pDst, len, scaleFactor)); }
+    template <> void subSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsSub_16u_Sfs(pSrc2, pSrc1, pDst, len, scaleFactor)); }
+    template <> void subSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsSub_32s_Sfs(pSrc2, pSrc1, pDst, len, scaleFactor)); }
+    //
+    template <> void subSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::subSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
+    template <> void subSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::subSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
+
+    // mulSfs
+    template <> void mulSfs(const uint8_t * pSrc1, const uint8_t * pSrc2, uint8_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsMul_8u_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void mulSfs(const int16_t * pSrc1, const int16_t * pSrc2, int16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsMul_16s_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void mulSfs(const uint16_t * pSrc1, const uint16_t * pSrc2, uint16_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsMul_16u_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    template <> void mulSfs(const int32_t * pSrc1, const int32_t * pSrc2, int32_t * pDst, int len, int scaleFactor) { STATUS_CHECK(
+        ippsMul_32s_Sfs(pSrc1, pSrc2, pDst, len, scaleFactor)); }
+    //
+    template <> void mulSfs(const int8_t * pSrc1, const int8_t * pSrc2, int8_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::mulSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
+    template <> void mulSfs(const uint32_t * pSrc1, const uint32_t * pSrc2, uint32_t * pDst, int len, int scaleFactor) {
+        nosimd::arithmetic::mulSfs(pSrc1, pSrc2, pDst, len, scaleFactor); }
 }
 
 namespace power
@@ -1,4 +1,5 @@
 #pragma once
+#include "nosimd.h"
 
 #ifdef max
 #undef max
@@ -31,6 +32,14 @@ namespace ipp
         _SIMD_EXT_T void move(const _T* pSrc, _T* pDst, int len);
 
         _SIMD_EXT_TU void convert(const _T* pSrc, _U* pDst, int len);
+        using nosimd::common::convertScale;
+        using nosimd::common::convertSfs;
+
+        // 16-bit float storage, through float on the host
+        inline void convert(const simd::float16_t* pSrc, float* pDst, int len) { nosimd::common::convert(pSrc, pDst, len); }
+        inline void convert(const float* pSrc, simd::float16_t* pDst, int len) { nosimd::common::convert(pSrc, pDst, len); }
+        inline void convert(const simd::bfloat16_t* pSrc, float* pDst, int len) { nosimd::common::convert(pSrc, pDst, len); }
+        inline void convert(const float* pSrc, simd::bfloat16_t* pDst, int len) { nosimd::common::convert(pSrc, pDst, len); }
     }
 
     namespace arithmetic
@@ -51,6 +60,15 @@ namespace ipp
 
         _SIMD_EXT_T void abs(const _T* pSrc, _T* pDst, int len);
 
+        // saturating, scaled by 2^-scaleFactor
+        _SIMD_EXT_T void addSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor);
+        _SIMD_EXT_T void subSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor);
+        _SIMD_EXT_T void mulSfs(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len, int scaleFactor);
+
+        template<typename _T> inline void addSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len) { addSfs(pSrc1, pSrc2, pDst, len, 0); }
+        template<typename _T> inline void subSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len) { subSfs(pSrc1, pSrc2, pDst, len, 0); }
+        template<typename _T> inline void mulSat(const _T* pSrc1, const _T* pSrc2, _T* pDst, int len) { mulSfs(pSrc1, pSrc2, pDst, len, 0); }
+
         namespace f21
         {
             void div(const float * pSrc1, const float * pSrc2, float * pDst, int len);
@@ -187,6 +205,18 @@ namespace ipp
 #endif
 
         _SIMD_EXT_TU void dotProd(const _T* pSrc1, const _T* pSrc2, int len, _U* pDp);
+
+        // 16-bit float storage, float accumulators on the host
+        inline void sum(const simd::float16_t* pSrc, int len, float* pSum) { nosimd::statistical::sum(pSrc, len, pSum); }
+        inline void sum(const simd::bfloat16_t* pSrc, int len, float* pSum) { nosimd::statistical::sum(pSrc, len, pSum); }
+        inline void dotProd(const simd::float16_t* pSrc1, const simd::float16_t* pSrc2, int len, float* pDp)
+        {
+            nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        }
+        inline void dotProd(const simd::bfloat16_t* pSrc1, const simd::bfloat16_t* pSrc2, int len, float* pDp)
+        {
+            nosimd::statistical::dotProd(pSrc1, pSrc2, len, pDp);
+        }
     }
 
     namespace trigonometric
@@ -2,10 +2,17 @@
 #include <memory>
 #include <cstdint>
 #include <limits>
+#include <cmath>
 
 #include "simd.h"
 #include "compare.h"
 
+#ifdef SIMD_OPENCL
+#include <cstdio>
+#include <string>
+#include "ocl_kernels.h"
+#endif
+
 template<typename T>
 void test_arithm(unsigned length, T value1, T value2, bool allowTrash = false)
 {
@@ -130,6 +137,604 @@ void test_abs(unsigned length = 47)
     }
 }
 
+// full range items: products wrap, in place and out of place
+template<typename T>
+void test_mul(unsigned length)
+{
+    auto pa = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    auto pb = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    auto presult = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    T * a = pa.get();
+    T * b = pb.get();
+    T * result = presult.get();
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        uint64_t h = (i + 1) * 0x9e3779b97f4a7c15ull;
+        h ^= h >> 29;
+        a[i] = T(h);
+        b[i] = T(h >> 32 | h << 32);
+    }
+
+    const T val = T(0xb5ad4eceda1ce2a9ull);
+    simd::mulC(a, val, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != T(uint64_t(a[i]) * uint64_t(val)))
+            FAIL();
+    }
+
+    simd::mul(a, b, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != T(uint64_t(a[i]) * uint64_t(b[i])))
+            FAIL();
+    }
+
+    simd::mul(result, b, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != T(uint64_t(a[i]) * uint64_t(b[i]) * uint64_t(b[i])))
+            FAIL();
+    }
+}
+
+// exact results of 8, 16 and 32-bit items, the product of uint32_t is unsigned
+template<typename T> struct Wide { typedef int64_t type; };
+template<> struct Wide<uint32_t> { typedef uint64_t type; };
+
+// x * 2^-scaleFactor: floor division, then half to even on the remainder
+template<typename T, typename W>
+T sat_ref(W x, int scaleFactor)
+{
+    const W lo = std::numeric_limits<T>::min();
+    const W hi = std::numeric_limits<T>::max();
+
+    if (scaleFactor < 0)
+    {
+        double up = std::ldexp(double(x), -scaleFactor);
+        if (up >= double(hi))
+            return T(hi);
+        if (up <= double(lo))
+            return T(lo);
+        return T(x * (W(1) << -scaleFactor));
+    }
+
+    if (scaleFactor > 0)
+    {
+        W d = W(1) << scaleFactor;
+        W q = x / d;
+        if (q * d > x)
+            q -= 1;
+        W r = x - q * d;
+        if (2 * r > d || (2 * r == d && q % 2 != 0))
+            q += 1;
+        x = q;
+    }
+    return (x < lo) ? T(lo) : (x > hi) ? T(hi) : T(x);
+}
+
+template<typename T>
+void test_sat(unsigned length)
+{
+    typedef typename Wide<T>::type W;
+
+    auto pa = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    auto pb = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    auto presult = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    T * a = pa.get();
+    T * b = pb.get();
+    T * result = presult.get();
+
+    const T lo = std::numeric_limits<T>::min();
+    const T hi = std::numeric_limits<T>::max();
+    for (unsigned i = 0; i < length; ++i)
+    {
+        uint32_t h = (i + 1) * 2654435761u;
+        h ^= h >> 13;
+        h *= 0x5bd1e995;
+        h ^= h >> 15;
+
+        switch (i % 9)
+        {
+            case 0: a[i] = hi; b[i] = hi; break;
+            case 1: a[i] = lo; b[i] = hi; break;
+            case 2: a[i] = lo; b[i] = lo; break;
+            case 3: case 4: a[i] = T(h & 0xff); b[i] = T((h >> 8) & 0xff); break;
+            default: a[i] = T(h); b[i] = T(h >> 16 | h << 16); break;
+        }
+    }
+
+    for (int sf : {0, 1, 3, 7, 30, -2})
+    {
+        simd::addSfs(a, b, result, length, sf);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            if (result[i] != sat_ref<T>(W(a[i]) + W(b[i]), sf))
+                FAIL();
+        }
+
+        simd::subSfs(a, b, result, length, sf);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            if (result[i] != sat_ref<T>(int64_t(a[i]) - int64_t(b[i]), sf))
+                FAIL();
+        }
+
+        simd::mulSfs(a, b, result, length, sf);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            if (result[i] != sat_ref<T>(W(a[i]) * W(b[i]), sf))
+                FAIL();
+        }
+    }
+
+    simd::addSat(a, b, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != sat_ref<T>(W(a[i]) + W(b[i]), 0))
+            FAIL();
+    }
+
+    simd::subSat(a, b, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != sat_ref<T>(int64_t(a[i]) - int64_t(b[i]), 0))
+            FAIL();
+    }
+
+    simd::mulSat(a, b, result, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (result[i] != sat_ref<T>(W(a[i]) * W(b[i]), 0))
+            FAIL();
+    }
+}
+
+#ifdef SIMD_OPENCL
+// small integers: every partial sum is exact, so any order of the device tree matches nosimd
+template<typename T>
+void test_ocl_statistical(unsigned length)
+{
+    auto pa = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    auto pb = std::shared_ptr<T>(simd::malloc<T>(length), simd::free<T>);
+    T * a = pa.get();
+    T * b = pb.get();
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        uint32_t h = (i + 1) * 2654435761u;
+        h ^= h >> 15;
+        a[i] = T(int(h % 15) - 7);
+        b[i] = T(int((h >> 8) % 15) - 7);
+    }
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        T r, ref;
+        T r2, ref2;
+        int idx, refIdx;
+
+        simd::sum(a, length, &r);
+        nosimd::statistical::sum(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::dotProd(a, b, length, &r);
+        nosimd::statistical::dotProd(a, b, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::min(a, length, &r);
+        nosimd::statistical::min(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::max(a, length, &r);
+        nosimd::statistical::max(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::minMax(a, length, &r, &r2);
+        nosimd::statistical::minMax(a, length, &ref, &ref2);
+        if (r != ref || r2 != ref2)
+            FAIL();
+
+        // ties go to the first index, nosimd leaves the index alone when it is 0
+        idx = -1;
+        refIdx = 0;
+        simd::minIndx(a, length, &r, &idx);
+        nosimd::statistical::minIndx(a, length, &ref, &refIdx);
+        if (r != ref || idx != refIdx)
+            FAIL();
+
+        idx = -1;
+        refIdx = 0;
+        simd::maxIndx(a, length, &r, &idx);
+        nosimd::statistical::maxIndx(a, length, &ref, &refIdx);
+        if (r != ref || idx != refIdx)
+            FAIL();
+
+        simd::normInf(a, length, &r);
+        nosimd::statistical::normInf(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::normL1(a, length, &r);
+        nosimd::statistical::normL1(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::normL2(a, length, &r);
+        nosimd::statistical::normL2(a, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::normDiffInf(a, b, length, &r);
+        nosimd::statistical::normDiffInf(a, b, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::normDiffL1(a, b, length, &r);
+        nosimd::statistical::normDiffL1(a, b, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        simd::normDiffL2(a, b, length, &r);
+        nosimd::statistical::normDiffL2(a, b, length, &ref);
+        if (r != ref)
+            FAIL();
+
+        // squared deviations from a rounded mean are not exact: compare with a double reference,
+        // one item has no deviation
+        const double tol = std::is_same<T, float>::value ? 1e-5 : 1e-12;
+        double mean, stdDev;
+        simd::meanStdDev(a, length, &r, &r2);
+        nosimd::statistical::meanStdDev(a, length, &mean, &stdDev);
+        if (std::fabs(r - mean) > tol * std::fmax(std::fabs(mean), 1.))
+            FAIL();
+        if (length > 1 && std::fabs(r2 - stdDev) > tol * std::fmax(stdDev, 1.))
+            FAIL();
+
+        // second pass: every item is a tie
+        for (unsigned i = 0; i < length; ++i)
+            a[i] = T(3);
+    }
+
+    // an empty device array has no buffer: sums and norms are 0 as on the host
+    ocl::DeviceArray<T> empty;
+    T r = T(1);
+    ocl::statistical::sum(empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::dotProd(empty, empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normInf(empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normL1(empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normL2(empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normDiffInf(empty, empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normDiffL1(empty, empty, &r);
+    if (r != T(0))
+        FAIL();
+    r = T(1);
+    ocl::statistical::normDiffL2(empty, empty, &r);
+    if (r != T(0))
+        FAIL();
+}
+
+// Accurate kernels stay in the item type group, Relaxed ones go to the -cl-fast-relaxed-math groups 10 and 11,
+// only float Native kernels call native_* builtins
+void test_ocl_math_programs()
+{
+    using namespace ocl::internals::Kernel;
+    unsigned length = 0;
+
+    for (uint32_t i = 0; i < mathCount(); ++i)
+    {
+        Precision prec = Precision(i / (uint32_t)MathOp::Count);
+        TextProgram f = program(Func((uint32_t)Func::Math_32f + i));
+        TextProgram d = program(Func((uint32_t)Func::Math_64f + i));
+        bool relaxed = (prec == Precision::Relaxed);
+
+        if (f.group != (relaxed ? 10u : TextProgram::typeGroup<float>()) ||
+            d.group != (relaxed ? 11u : TextProgram::typeGroup<double>()))
+            FAIL();
+        if (std::string(groupOptions(f.group)).empty() == relaxed ||
+            std::string(groupOptions(d.group)).empty() == relaxed)
+            FAIL();
+        if (f.width != 4 || d.width != 2)
+            FAIL();
+        if (std::string(d.text).find("native_") != std::string::npos)
+            FAIL();
+        if (prec != Precision::Native && std::string(f.text).find("native_") != std::string::npos)
+            FAIL();
+    }
+
+    if (std::string(program(Func((uint32_t)Func::Math_32f + mathIndex(MathOp::Sin, Precision::Native))).text)
+            .find("native_sin") == std::string::npos)
+        FAIL();
+}
+
+template<typename T> using MathUnary = void (*)(const T *, T *, int);
+template<typename T> using MathBinary = void (*)(const T *, const T *, T *, int);
+template<typename T> using MathPowx = void (*)(const T *, T, T *, int);
+
+// x in [lo, hi), y in [-3, 3); the reference runs nosimd in double
+template<typename T>
+struct MathData
+{
+    std::shared_ptr<T> px, py, presult;
+    std::shared_ptr<double> pxd, pyd, pref;
+    T * x;
+    T * y;
+    T * result;
+    double * xd;
+    double * yd;
+    double * ref;
+
+    MathData(unsigned length, double lo, double hi)
+    :   px(simd::malloc<T>(length), simd::free<T>),
+        py(simd::malloc<T>(length), simd::free<T>),
+        presult(simd::malloc<T>(length), simd::free<T>),
+        pxd(new double[length], std::default_delete<double[]>()),
+        pyd(new double[length], std::default_delete<double[]>()),
+        pref(new double[length], std::default_delete<double[]>()),
+        x(px.get()), y(py.get()), result(presult.get()), xd(pxd.get()), yd(pyd.get()), ref(pref.get())
+    {
+        for (unsigned i = 0; i < length; ++i)
+        {
+            uint32_t h = (i + 1) * 2654435761u;
+            h ^= h >> 15;
+            x[i] = T(lo + (hi - lo) * ((h & 0xffff) / 65536.));
+            y[i] = T(-3 + 6 * ((h >> 16) / 65536.));
+            xd[i] = x[i];
+            yd[i] = y[i];
+        }
+    }
+
+    // relative above 1, absolute below
+    bool near(unsigned i, double tol) const
+    {
+        return std::fabs(result[i] - ref[i]) <= tol * std::fmax(std::fabs(ref[i]), 1.);
+    }
+};
+
+template<typename T>
+void test_math_unary(unsigned length, double tol, double lo, double hi, MathUnary<T> func, MathUnary<double> ref)
+{
+    MathData<T> d(length, lo, hi);
+    func(d.x, d.result, length);
+    ref(d.xd, d.ref, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (!d.near(i, tol))
+            FAIL();
+    }
+}
+
+template<typename T>
+void test_math_binary(unsigned length, double tol, double lo, double hi, MathBinary<T> func, MathBinary<double> ref)
+{
+    MathData<T> d(length, lo, hi);
+    func(d.x, d.y, d.result, length);
+    ref(d.xd, d.yd, d.ref, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (!d.near(i, tol))
+            FAIL();
+    }
+}
+
+template<typename T>
+void test_math_powx(unsigned length, double tol, MathPowx<T> func, MathPowx<double> ref)
+{
+    MathData<T> d(length, 0.5, 2);
+    func(d.x, T(2.5), d.result, length);
+    ref(d.xd, 2.5, d.ref, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (!d.near(i, tol))
+            FAIL();
+    }
+}
+
+#define TEST_OCL_MATH(T, ns, tol) \
+    test_math_unary<T>(length, tol, 0.1, 10, ns::inv, nosimd::power::inv<double>); \
+    test_math_unary<T>(length, tol, 0.1, 10, ns::sqrt, nosimd::power::sqrt<double>); \
+    test_math_unary<T>(length, tol, 0.1, 10, ns::invSqrt, nosimd::power::invSqrt<double>); \
+    test_math_unary<T>(length, tol, -10, 10, ns::cbrt, nosimd::power::cbrt<double>); \
+    test_math_powx<T>(length, tol, ns::powx, nosimd::power::powx<double>); \
+    test_math_binary<T>(length, tol, 0.5, 2, ns::pow, nosimd::power::pow<double>); \
+    test_math_binary<T>(length, tol, -10, 10, ns::hypot, nosimd::power::hypot<double>); \
+    test_math_unary<T>(length, tol, -5, 5, ns::exp, nosimd::exp_log::exp<double>); \
+    test_math_unary<T>(length, tol, 0.1, 10, ns::ln, nosimd::exp_log::ln<double>); \
+    test_math_unary<T>(length, tol, -3, 3, ns::sin, nosimd::trigonometric::sin<double>); \
+    test_math_unary<T>(length, tol, -3, 3, ns::cos, nosimd::trigonometric::cos<double>); \
+    test_math_unary<T>(length, tol, -1.2, 1.2, ns::tan, nosimd::trigonometric::tan<double>); \
+    test_math_unary<T>(length, tol, -0.99, 0.99, ns::asin, nosimd::trigonometric::asin<double>); \
+    test_math_unary<T>(length, tol, -0.99, 0.99, ns::acos, nosimd::trigonometric::acos<double>); \
+    test_math_unary<T>(length, tol, -10, 10, ns::atan, nosimd::trigonometric::atan<double>)
+
+// accurate builtins are within 16 ulp (pow), native_* and relaxed math are device defined
+void test_ocl_math(unsigned length)
+{
+    const double f24 = 32 * std::numeric_limits<float>::epsilon();
+    const double d53 = 32 * std::numeric_limits<double>::epsilon();
+    const double f21 = 1e-3;
+    const double d50 = 1e-10;
+
+    TEST_OCL_MATH(float, ocl, f24);
+    TEST_OCL_MATH(float, ocl::f24, f24);
+    TEST_OCL_MATH(float, ocl::f21, f21);
+    TEST_OCL_MATH(double, ocl, d53);
+    TEST_OCL_MATH(double, ocl::d53, d53);
+    TEST_OCL_MATH(double, ocl::d50, d50);
+}
+
+// fused expressions match the op by op device calls; a new scalar reuses the kernel, a new shape builds one
+void test_ocl_fused()
+{
+    using ocl::fused::Expr;
+    using ocl::DeviceArray;
+    const ocl::Context ctx = ocl::defaultContext();
+    const size_t kernels = ocl::fused::kernelCount(ctx);
+
+    for (unsigned length : {1u, 1021u, 4096u})
+    {
+        auto pa = std::shared_ptr<int32_t>(simd::malloc<int32_t>(length), simd::free<int32_t>);
+        auto pb = std::shared_ptr<int32_t>(simd::malloc<int32_t>(length), simd::free<int32_t>);
+        auto presult = std::shared_ptr<int32_t>(simd::malloc<int32_t>(length), simd::free<int32_t>);
+        auto pexpected = std::shared_ptr<int32_t>(simd::malloc<int32_t>(length), simd::free<int32_t>);
+        int32_t * a = pa.get();
+        int32_t * b = pb.get();
+        int32_t * result = presult.get();
+        int32_t * expected = pexpected.get();
+
+        for (unsigned i = 0; i < length; ++i)
+        {
+            uint32_t h = (i + 1) * 2654435761u;
+            h ^= h >> 15;
+            a[i] = int32_t(h % 201) - 100;
+            b[i] = int32_t((h >> 8) % 201) - 100;
+        }
+
+        DeviceArray<int32_t> da(a, length), db(b, length), s, t, u, dst;
+        Expr<int32_t> x(da), y(db);
+        Expr<int32_t> sum = x + y;
+
+        for (int32_t c : {3, -7})
+        {
+            ocl::fused::evaluate(sum * x - sum * c, dst);
+            if (ocl::fused::kernelCount(ctx) != kernels + 1)
+                FAIL();
+
+            ocl::arithmetic::add(da, db, s);
+            ocl::arithmetic::mul(s, da, t);
+            ocl::arithmetic::mulC(s, c, u);
+            ocl::arithmetic::sub(t, u, s);
+
+            dst.download(result);
+            s.download(expected);
+            for (unsigned i = 0; i < length; ++i)
+            {
+                if (result[i] != expected[i])
+                    FAIL();
+            }
+        }
+
+        // the float example of ocl.h: sqrt is left to the host in the unfused version
+        auto pf = std::shared_ptr<float>(simd::malloc<float>(length), simd::free<float>);
+        auto pg = std::shared_ptr<float>(simd::malloc<float>(length), simd::free<float>);
+        float * f = pf.get();
+        float * g = pg.get();
+        for (unsigned i = 0; i < length; ++i)
+        {
+            f[i] = a[i] * 0.1f;
+            g[i] = b[i] * 0.1f;
+        }
+
+        DeviceArray<float> df(f, length), dg(g, length), fdst, fx, fy;
+        Expr<float> xf(df);
+        Expr<float> yf(dg);
+        ocl::fused::evaluate(sqrt(xf * xf + yf * yf) * 0.5f, fdst);
+        if (ocl::fused::kernelCount(ctx) != kernels + 2)
+            FAIL();
+
+        ocl::arithmetic::mul(df, df, fx);
+        ocl::arithmetic::mul(dg, dg, fy);
+        ocl::arithmetic::add(fx, fy, fx);
+        fx.download(g);
+        nosimd::power::sqrt(g, g, length);
+        fdst.download(f);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            if (std::fabs(f[i] - g[i] * 0.5f) > 8 * std::numeric_limits<float>::epsilon() * std::fmax(g[i], 1.f))
+                FAIL();
+        }
+    }
+}
+#endif
+
+#ifdef SIMD_INSTRUMENT
+// every test_arithm<float> adds once
+void test_instrument(unsigned start, unsigned end, unsigned inc)
+{
+    uint64_t calls = 0;
+    uint64_t elements = 0;
+    for (unsigned len = start; len < end; len+=inc)
+    {
+        ++calls;
+        elements += len;
+    }
+
+    // find's length is its third argument, not the last one
+    float items[100] = {};
+    int pos = -1;
+    simd::find(items, 1.f, 100, &pos);
+
+    unsigned length = end;
+    bool sawAdd = false;
+    bool sawFind = false;
+    for (const instrument::Entry& e : instrument::snapshot())
+    {
+        if (std::string(instrument::typeName(e.type)) != "32f")
+            continue;
+
+        if (e.func == instrument::Func::add)
+        {
+            uint64_t histogram = 0;
+            for (uint64_t count : e.histogram)
+                histogram += count;
+            if (e.calls != calls || e.elements != elements || histogram != calls)
+                FAIL();
+            sawAdd = true;
+        }
+        else if (e.func == instrument::Func::find)
+        {
+            // 100 is in bucket 7, [64, 128)
+            if (e.calls != 1 || e.elements != 100 || e.histogram[7] != 1)
+                FAIL();
+            sawFind = true;
+        }
+    }
+    if (!sawAdd || !sawFind)
+        FAIL();
+}
+#endif
+
+#ifdef SIMD_FALLBACK_REPORT
+// integer division has no SSE kernel
+void test_fallback()
+{
+    unsigned length = 0;
+    for (const simd::fallback::Entry& e : simd::fallback::report())
+    {
+        if (e.function.find("div") != std::string::npos && e.function.find("int") != std::string::npos)
+        {
+            if (!e.calls || !e.elements)
+                FAIL();
+            return;
+        }
+    }
+    FAIL();
+}
+#endif
+
 int main()
 {
     try
@@ -163,11 +768,15 @@ int main()
             test_arithm<uint32_t>(len, 2, 1, allowTrash);
             test_abs<int32_t>(len);
             test_abs<uint32_t>(len);
+            test_sat<int32_t>(len);
+            test_sat<uint32_t>(len);
 
             test_arithm<int64_t>(len, 2, 1, allowTrash);
             test_arithm<uint64_t>(len, 2, 1, allowTrash);
             test_abs<int64_t>(len);
             test_abs<uint64_t>(len);
+            test_mul<int64_t>(len);
+            test_mul<uint64_t>(len);
         }
 
 #ifndef NO_8_16
@@ -178,7 +787,35 @@ int main()
             test_arithm<uint16_t>(len, 2, 1, allowTrash);
             test_abs<int16_t>(len);
             test_abs<int8_t>(len);
+            test_mul<int8_t>(len);
+            test_mul<uint8_t>(len);
+            test_sat<int8_t>(len);
+            test_sat<uint8_t>(len);
+            test_sat<int16_t>(len);
+            test_sat<uint16_t>(len);
+        }
+#endif
+#ifdef SIMD_OPENCL
+        test_ocl_math_programs();
+
+        // lengths off the work group size, one and several groups
+        for (unsigned len : {1u, 2u, 3u, 63u, 65u, 255u, 257u, 1000u, 4099u, 65537u})
+        {
+            test_ocl_statistical<float>(len);
+            test_ocl_statistical<double>(len);
         }
+
+        // vector tails: float4 and double2 work items
+        for (unsigned len : {1u, 3u, 5u, 6u, 7u, 66u, 1021u, 4097u})
+            test_ocl_math(len);
+
+        test_ocl_fused();
+#endif
+#ifdef SIMD_INSTRUMENT
+        test_instrument(start, end, inc);
+#endif
+#ifdef SIMD_FALLBACK_REPORT
+        test_fallback();
 #endif
     }
     catch (const simd::Exception& ex) {
@@ -1,3 +1,5 @@
+#include <cmath>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -24,37 +26,324 @@ void test_convert(unsigned length, _T value)
     }
 }
 
+// distinct items catch lanes out of order
+template<typename _T, typename _U>
+void test_convert_ramp(unsigned length)
+{
+    auto pt = std::shared_ptr<_T>(simd::malloc<_T>(length), simd::free<_T>);
+    auto pu = std::shared_ptr<_U>(simd::malloc<_U>(length), simd::free<_U>);
+    _T * t = pt.get();
+    _U * u = pu.get();
+
+    for (unsigned i = 0; i < length; ++i)
+        t[i] = (_T)(i * 0x01010101u * 37 + 11);
+    simd::convert(t, u, length);
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (u[i] != (_U)t[i])
+            FAIL();
+    }
+}
+
+// fractions of both signs: float to int32 truncates like the cast
+template<typename _T, typename _U>
+void test_convert_frac(unsigned length)
+{
+    auto pt = std::shared_ptr<_T>(simd::malloc<_T>(length), simd::free<_T>);
+    auto pu = std::shared_ptr<_U>(simd::malloc<_U>(length), simd::free<_U>);
+    _T * t = pt.get();
+    _U * u = pu.get();
+
+    for (unsigned i = 0; i < length; ++i)
+        t[i] = (_T)((int(i * 7919 % 2001) - 1000) * 0.37 + 1e-9 * i);
+    simd::convert(t, u, length);
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (u[i] != (_U)t[i])
+            FAIL();
+    }
+}
+
+void test_ramp(unsigned len)
+{
+    test_convert_ramp<int32_t, float>(len);
+    test_convert_ramp<int32_t, double>(len);
+    test_convert_frac<float, double>(len);
+    test_convert_frac<float, int32_t>(len);
+    test_convert_frac<double, float>(len);
+    test_convert_frac<double, int32_t>(len);
+
+    test_convert_ramp<int8_t, int16_t>(len);
+    test_convert_ramp<int8_t, int32_t>(len);
+    test_convert_ramp<int8_t, int64_t>(len);
+    test_convert_ramp<uint8_t, uint16_t>(len);
+    test_convert_ramp<uint8_t, uint32_t>(len);
+    test_convert_ramp<uint8_t, uint64_t>(len);
+    test_convert_ramp<int16_t, int8_t>(len);
+    test_convert_ramp<int16_t, int32_t>(len);
+    test_convert_ramp<int16_t, int64_t>(len);
+    test_convert_ramp<uint16_t, uint8_t>(len);
+    test_convert_ramp<uint16_t, uint32_t>(len);
+    test_convert_ramp<uint16_t, uint64_t>(len);
+    test_convert_ramp<int32_t, int16_t>(len);
+    test_convert_ramp<int32_t, int64_t>(len);
+    test_convert_ramp<uint32_t, uint16_t>(len);
+    test_convert_ramp<uint32_t, uint64_t>(len);
+}
+
+// both directions stay in range of the integer type, so the scalar cast is defined
+template<typename _T, typename _U>
+void test_scale_ramp(unsigned length, float from, float delta, float scale, float offset)
+{
+    auto pt = std::shared_ptr<_T>(simd::malloc<_T>(length), simd::free<_T>);
+    auto pu = std::shared_ptr<_U>(simd::malloc<_U>(length), simd::free<_U>);
+    _T * t = pt.get();
+    _U * u = pu.get();
+
+    for (unsigned i = 0; i < length; ++i)
+        t[i] = (_T)(from + delta * (i % 251));
+
+    simd::convert(t, u, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (u[i] != (_U)t[i])
+            FAIL();
+    }
+
+    simd::convertScale(t, u, length, scale, offset);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (u[i] != (_U)(t[i] * scale + offset))
+            FAIL();
+    }
+}
+
+void test_scale(unsigned len)
+{
+    test_scale_ramp<int8_t, float>(len, -125, 1, 1/127.f, 0.5f);
+    test_scale_ramp<uint8_t, float>(len, 0, 1, 1/255.f, 0);
+    test_scale_ramp<int16_t, float>(len, -30000, 239, 1/32768.f, 0);
+    test_scale_ramp<uint16_t, float>(len, 0, 261, 1/65535.f, 1);
+    test_scale_ramp<float, int8_t>(len, -120.5f, 0.96f, 0.5f, 3);
+    test_scale_ramp<float, uint8_t>(len, 0.25f, 1.01f, 0.5f, 100);
+    test_scale_ramp<float, int16_t>(len, -32000.5f, 255, 0.5f, -7);
+    test_scale_ramp<float, uint16_t>(len, 0.75f, 261, 0.5f, 1000);
+}
+
+// reference in double: the power of two scale is exact in both types
+template<typename _U>
+_U sfs_ref(float x, simd::RoundMode mode, int scaleFactor)
+{
+    double v = std::ldexp(double(x), -scaleFactor);
+    switch (mode)
+    {
+        case simd::RoundMode::Near: v = std::nearbyint(v); break;
+        case simd::RoundMode::Zero: v = std::trunc(v); break;
+        case simd::RoundMode::Down: v = std::floor(v); break;
+        case simd::RoundMode::Up: v = std::ceil(v); break;
+    }
+
+    if (std::isnan(v))
+        return 0;
+    if (v <= std::numeric_limits<_U>::min())
+        return std::numeric_limits<_U>::min();
+    if (v >= std::numeric_limits<_U>::max())
+        return std::numeric_limits<_U>::max();
+    return (_U)v;
+}
+
+// ramp past both limits of _U with ties, small fractions, NaN and infinities
+template<typename _U>
+void test_convert_sfs(unsigned length, float from, float delta)
+{
+    auto pt = std::shared_ptr<float>(simd::malloc<float>(length), simd::free<float>);
+    auto pu = std::shared_ptr<_U>(simd::malloc<_U>(length), simd::free<_U>);
+    float * t = pt.get();
+    _U * u = pu.get();
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (i % 13 == 12)
+            t[i] = std::numeric_limits<float>::quiet_NaN();
+        else if (i % 17 == 16)
+            t[i] = (i & 32) ? -std::numeric_limits<float>::infinity() : std::numeric_limits<float>::infinity();
+        else if (i % 5 == 4)
+            t[i] = (i % 251) * 0.25f - 31;
+        else
+            t[i] = from + delta * (i % 251);
+    }
+
+    const simd::RoundMode modes[] = { simd::RoundMode::Near, simd::RoundMode::Zero, simd::RoundMode::Down, simd::RoundMode::Up };
+    for (simd::RoundMode mode : modes)
+    {
+        for (int scaleFactor : { 0, 1, -2 })
+        {
+            simd::convertSfs(t, u, length, mode, scaleFactor);
+            for (unsigned i = 0; i < length; ++i)
+            {
+                if (u[i] != sfs_ref<_U>(t[i], mode, scaleFactor))
+                    FAIL();
+            }
+        }
+    }
+}
+
+void test_sfs(unsigned len)
+{
+    test_convert_sfs<int8_t>(len, -300, 2.5f);
+    test_convert_sfs<uint8_t>(len, -20.5f, 1.25f);
+    test_convert_sfs<int16_t>(len, -40000, 320.5f);
+    test_convert_sfs<uint16_t>(len, -1000, 270.5f);
+    test_convert_sfs<int32_t>(len, -3e9f, 2.4e7f);
+}
+
+// every 16-bit pattern through float and back, NaN only has to stay NaN
+template<typename _H>
+void test_half_patterns()
+{
+    const unsigned length = 65536;
+    auto ph = std::shared_ptr<_H>(simd::malloc<_H>(length), simd::free<_H>);
+    auto pf = std::shared_ptr<float>(simd::malloc<float>(length), simd::free<float>);
+    _H * h = ph.get();
+    float * f = pf.get();
+
+    for (unsigned i = 0; i < length; ++i)
+        h[i].bits = i;
+
+    simd::convert(h, f, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        float expected = _H::toFloat(i);
+        if (std::isnan(expected) ? !std::isnan(f[i]) : memcmp(&expected, &f[i], sizeof(float)))
+            FAIL();
+    }
+
+    simd::convert(f, h, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (std::isnan(f[i]) ? !std::isnan(_H::toFloat(h[i].bits)) : h[i].bits != i)
+            FAIL();
+    }
+}
+
+// float bit patterns, most of them in half range and many exact ties, against the scalar rounding
+template<typename _H>
+void test_half_round(unsigned length)
+{
+    auto pf = std::shared_ptr<float>(simd::malloc<float>(length), simd::free<float>);
+    auto ph = std::shared_ptr<_H>(simd::malloc<_H>(length), simd::free<_H>);
+    float * f = pf.get();
+    _H * h = ph.get();
+
+    for (unsigned i = 0; i < length; ++i)
+    {
+        uint32_t x = (i + 1) * 0x9e3779b1u;
+        if (i % 4)
+            x = (x & 0x807fffff) | (((x >> 23) % 40 + 100) << 23);
+        if (i % 4 == 1)
+            x = (x & 0xffffe000) | 0x1000; // float16 tie
+        if (i % 4 == 2)
+            x = (x & 0xffff0000) | 0x8000; // bfloat16 tie
+        memcpy(&f[i], &x, sizeof(float));
+    }
+
+    simd::convert(f, h, length);
+    for (unsigned i = 0; i < length; ++i)
+    {
+        if (h[i].bits != _H::fromFloat(f[i]))
+            FAIL();
+    }
+}
+
+// eighths of small integers: sums and products are exact in float
+template<typename _H>
+void test_half_reduce(unsigned length)
+{
+    auto p1 = std::shared_ptr<_H>(simd::malloc<_H>(length), simd::free<_H>);
+    auto p2 = std::shared_ptr<_H>(simd::malloc<_H>(length), simd::free<_H>);
+    _H * a = p1.get();
+    _H * b = p2.get();
+
+    double sum = 0, dp = 0;
+    for (unsigned i = 0; i < length; ++i)
+    {
+        float x = (int(i % 61) - 30) / 8.f;
+        float y = (int(i * 7 % 53) - 26) / 8.f;
+        a[i] = x;
+        b[i] = y;
+        sum += x;
+        dp += double(x) * y;
+    }
+
+    float s, d;
+    simd::sum(a, length, &s);
+    simd::dotProd(a, b, length, &d);
+    if (s != sum || d != dp)
+        FAIL();
+}
+
+void test_half(unsigned len)
+{
+    test_half_round<simd::float16_t>(len);
+    test_half_round<simd::bfloat16_t>(len);
+    test_half_reduce<simd::float16_t>(len);
+    test_half_reduce<simd::bfloat16_t>(len);
+}
+
 void test_i8(unsigned len, int value)
 {
     test_convert<int8_t, int16_t>(len, value);
+    test_convert<int8_t, int32_t>(len, value);
+    test_convert<int8_t, int64_t>(len, value);
     test_convert<int8_t, float>(len, value);
+    test_convert<float, int8_t>(len, value);
 }
 
 void test_u8(unsigned len, int value)
 {
+    test_convert<uint8_t, uint16_t>(len, value);
+    test_convert<uint8_t, uint32_t>(len, value);
+    test_convert<uint8_t, uint64_t>(len, value);
     test_convert<uint8_t, float>(len, value);
+    test_convert<float, uint8_t>(len, value);
 }
 
 void test_i16(unsigned len, int value)
 {
+    test_convert<int16_t, int8_t>(len, value);
     test_convert<int16_t, int32_t>(len, value);
+    test_convert<int16_t, int64_t>(len, value);
     test_convert<int32_t, int16_t>(len, value);
     test_convert<int16_t, float>(len, value);
+    test_convert<float, int16_t>(len, value);
 }
 
 void test_u16(unsigned len, int value)
 {
+    test_convert<uint16_t, uint8_t>(len, value);
+    test_convert<uint16_t, uint32_t>(len, value);
+    test_convert<uint16_t, uint64_t>(len, value);
     test_convert<uint16_t, float>(len, value);
+    test_convert<float, uint16_t>(len, value);
 }
 
 void test_i32(unsigned len, int value)
 {
     test_convert<int32_t, float>(len, value);
     test_convert<int32_t, double>(len, value);
+    test_convert<int32_t, int64_t>(len, value);
     test_convert<float, int32_t>(len, value);
     test_convert<double, int32_t>(len, value);
 }
 
+void test_u32(unsigned len, uint32_t value)
+{
+    test_convert<uint32_t, uint16_t>(len, value);
+    test_convert<uint32_t, uint64_t>(len, value);
+}
+
 void test_i64(unsigned len, int64_t value)
 {
     test_convert<int64_t, double>(len, value);
@@ -72,6 +361,9 @@ int main()
 
     try
     {
+        test_half_patterns<simd::float16_t>();
+        test_half_patterns<simd::bfloat16_t>();
+
         for (unsigned len = 0; len < 128; ++len)
         {
             test_i8(len, 42);
@@ -94,10 +386,20 @@ int main()
             test_i32(len, numeric_limits<int32_t>::min());
             test_i32(len, numeric_limits<int32_t>::max());
 
+            test_u32(len, 42);
+            test_u32(len, numeric_limits<uint32_t>::min());
+            test_u32(len, numeric_limits<uint32_t>::max());
+            test_u32(len, 0x12345678);
+
             test_i64(len, 42);
             test_i64(len, numeric_limits<int64_t>::min());
             test_i64(len, numeric_limits<int64_t>::max());
 
+            test_ramp(len);
+            test_scale(len);
+            test_sfs(len);
+            test_half(len);
+
             test_float(len, 42);
             test_float(len, numeric_limits<float>::min());
             test_float(len, numeric_limits<float>::max());